@@ -0,0 +1,226 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "os_delay.h"
+#include "bench.h"
+
+// ============================================================
+//  BENCH_SELECT  (main  os_init ֮start_scheduler ֮ǰ)
+// ============================================================
+void bench_start(void)
+{
+#if BENCH_SELECT != BENCH_NONE
+    //  DWT ڼ (Զʱ)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    printf("\r\n[bench] core %u MHz\r\n", (unsigned)(SystemCoreClock / 1000000u));
+#endif
+
+    // ԤѡûѡеĲһãʱļ (ľ̬) ᱻ
+#if BENCH_SELECT == BENCH_TICK_ISR
+    bench_tick_isr_start();
+#elif BENCH_SELECT == BENCH_PRIO_LOOKUP
+    bench_prio_lookup_start();
+#elif BENCH_SELECT == BENCH_INVERSION
+    bench_inversion_start();
+#elif BENCH_SELECT == BENCH_THRESHOLD
+    bench_threshold_start();
+#elif BENCH_SELECT == BENCH_SCHED
+    bench_sched_start();
+#elif BENCH_SELECT == BENCH_IRQ_LATENCY
+    bench_irq_latency_start();
+#elif BENCH_SELECT == BENCH_SWITCH
+    bench_switch_start();
+#elif BENCH_SELECT == BENCH_FPU
+    bench_fpu_start();
+#elif BENCH_SELECT == BENCH_ISR_YIELD
+    bench_isr_yield_start();
+#elif BENCH_SELECT == BENCH_SEM
+    bench_sem_start();
+#elif BENCH_SELECT == BENCH_TIMEOUT_RACE
+    bench_timeout_race_start();
+#elif BENCH_SELECT == BENCH_QUEUE
+    bench_queue_start();
+#elif BENCH_SELECT == BENCH_RINGBUF
+    bench_ringbuf_start();
+#elif BENCH_SELECT == BENCH_STREAM
+    bench_stream_start();
+#elif BENCH_SELECT == BENCH_NOTIFY
+    bench_notify_start();
+#elif BENCH_SELECT == BENCH_MEM
+    bench_mem_start();
+#endif
+}
+
+// ============================================================
+// Ĺ
+// ============================================================
+
+// ͷã˯һᣬôڰϢꡢȴٴ
+void bench_begin(const char *title)
+{
+    os_delay(10);
+    printf("[bench] %s\r\n", title);
+}
+
+// õ (ջͳһ BENCH_STACK_DEPTH)
+task_tcb* bench_spawn(void *task_function, char *task_name, uint32_t task_priority)
+{
+    return task_create(task_function, BENCH_STACK_DEPTH, task_name, task_priority);
+}
+
+// ˯ Tick (Ѿ˾Ͳ˯)ٽֵΪмһ Tick ˯һ
+void bench_sleep_until(uint32_t tick)
+{
+    uint32_t now;
+
+    task_enter_critical();
+    now = os_get_tick();
+    if ((int32_t)(tick - now) > 0)
+    {
+        os_delay(tick - now);
+    }
+    task_exit_critical();
+}
+
+// ÿĿѭ (һε bench_busy ʱ DWT У׼)
+static uint32_t busy_loops_per_ms;
+
+static void bench_busy_loop(uint32_t n)
+{
+    volatile uint32_t i = n;
+
+    while (i != 0)
+    {
+        i--;
+    }
+}
+
+//  us ΢Ļ ( CPU ѭѭ㣬ռǶʱ䲻)
+//  cpu_delay_us һǸǽʱȣռʱҲڼʱ
+void bench_busy(uint32_t us)
+{
+    if (busy_loops_per_ms == 0)
+    {
+        uint32_t cycles;
+
+        // ŵȺ SysTick  10000 ȦҪ
+        task_enter_critical();
+        cycles = BENCH_CYCLES();
+        bench_busy_loop(10000);
+        cycles = BENCH_CYCLES() - cycles;
+        task_exit_critical();
+
+        busy_loops_per_ms = (uint32_t)((uint64_t)10000 * (SystemCoreClock / 1000u) / cycles);
+    }
+
+    bench_busy_loop((uint32_t)((uint64_t)us * busy_loops_per_ms / 1000u));
+}
+
+// ============================================================
+// ͳƺͼʱ
+// ============================================================
+void bench_stat_add(bench_stat_t *st, uint32_t cycles)
+{
+    st->sum += cycles;
+    st->count++;
+    if (cycles > st->max) st->max = cycles;
+}
+
+static void bench_nop(void)
+{
+}
+
+//  CYCCNT мһպҪ (һ bench_loop ʱ0 = û)
+static uint32_t bench_overhead;
+
+//  fn һ loops Σÿεʱ۵ʱͺñĿǽ st
+// ÿεʱܿһΣм SysTick ֮жϣһλֵ
+void bench_loop(bench_stat_t *st, bench_fn_t fn, uint32_t loops)
+{
+    bench_fn_t volatile nop = bench_nop; //  volatile ͱ⺯һĺ
+    uint32_t i, t0, dt;
+
+    if (bench_overhead == 0)
+    {
+        bench_overhead = 0xFFFFFFFFu;
+        for (i = 0; i < 16; i++)
+        {
+            t0 = BENCH_CYCLES();
+            nop();
+            dt = BENCH_CYCLES() - t0;
+            if (dt < bench_overhead) bench_overhead = dt;
+        }
+    }
+
+    for (i = 0; i < loops; i++)
+    {
+        t0 = BENCH_CYCLES();
+        fn();
+        dt = BENCH_CYCLES() - t0;
+        bench_stat_add(st, (dt > bench_overhead) ? (dt - bench_overhead) : 0);
+    }
+}
+
+//  fn ӡƽ
+void bench_measure(const char *name, bench_fn_t fn, uint32_t loops)
+{
+    bench_stat_t st = {0, 0, 0};
+
+    bench_loop(&st, fn, loops);
+    bench_report_stat(name, &st);
+}
+
+// ============================================================
+// ӡ
+// ============================================================
+
+// ӡһ /  = ƽÿζڡ
+void bench_report(const char *name, uint64_t cycles, uint32_t count)
+{
+    uint32_t avg;
+
+    if (count == 0) count = 1;
+    avg = (uint32_t)(cycles / count);
+
+    printf("[bench] %-28s %8u cycles  %8u ns  (n=%u)\r\n",
+           name, (unsigned)avg, (unsigned)BENCH_CYCLES_TO_NS(avg), (unsigned)count);
+}
+
+// ƽ + 
+void bench_report_stat(const char *name, const bench_stat_t *st)
+{
+    bench_report(name, st->sum, st->count);
+    printf("[bench]   max %u cycles\r\n", (unsigned)st->max);
+}
+
+// cycles ﴦ count  unitۺÿٸ
+void bench_report_rate(uint32_t count, uint32_t cycles, const char *unit)
+{
+    if (cycles == 0) cycles = 1;
+    printf("[bench]   %u %s/s\r\n", (unsigned)((uint64_t)count * SystemCoreClock / cycles), unit);
+}
+
+// ֵλС (ÿжϼ PendSV)
+void bench_report_ratio(uint32_t num, uint32_t den, const char *what)
+{
+    if (den == 0) den = 1;
+    printf("[bench]   %u.%02u %s\r\n", (unsigned)(num / den), (unsigned)((uint64_t)(num % den) * 100u / den), what);
+}
+
+// ˣһֱ˯ӡ
+void bench_park(void)
+{
+    while (1)
+    {
+        os_delay(OS_DELAY_MAX_TICKS);
+    }
+}
+
+// ˣǣȻһֱ˯ ()
+void bench_finish(void)
+{
+    printf("[bench] done\r\n");
+    bench_park();
+}
@@ -0,0 +1,93 @@
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "stm32f4xx.h"
+#include "os_config.h"
+#include "task.h"
+
+// ============================================================
+// ܲ
+//  DWT ڼʱ (start_scheduler Ѿ) printf  (USART1, 115200)
+// һֻһ BENCH_SELECT ѡãأ
+// ============================================================
+#define BENCH_NONE              0
+#define BENCH_TICK_ISR          1   // Tick жϺʱ vs ˯ (ʱ)
+#define BENCH_PRIO_LOOKUP       2   // ȼңλͼ vs ɨ
+#define BENCH_INVERSION         3   // ȼתź vs 
+#define BENCH_THRESHOLD         4   // ռֵˮл
+#define BENCH_SCHED             5   // EDF vs ʣɵ
+#define BENCH_IRQ_LATENCY       6   // ȼжӳ٣BASEPRI vs ȫж
+#define BENCH_SWITCH            7   // PendSV лӳ٣л vs л
+#define BENCH_FPU               8   // л vs 
+#define BENCH_ISR_YIELD         9   // жϻѶÿжϼ PendSV
+#define BENCH_SEM               10  // ޾źÿ take/give 
+#define BENCH_TIMEOUT_RACE      11  // ʱͷײͬһ Tick˲
+#define BENCH_QUEUE             12  // ϢϢ vs 
+#define BENCH_RINGBUF           13  // λ
+#define BENCH_STREAM            14  // ֽ vs һһֽڵ
+#define BENCH_NOTIFY            15  // ֪ͨź vs ź
+#define BENCH_MEM               16  // ڴ vs ѣ + ͷŵ
+
+//*ҪܵĲ (BENCH_NONE ʲôܣҲڹ̵Ԥﶨ BENCH_SELECT=n)
+#ifndef BENCH_SELECT
+#define BENCH_SELECT            BENCH_NONE
+#endif
+
+//*ȼ (ȶʱͣȲｨ񶼸)
+#define BENCH_PRIORITY          (MAX_PRIORITY - 2)
+
+//*ջ (λ)
+#define BENCH_STACK_DEPTH       256
+
+// ڼ (168MHz  25 һΣβ޷Ųֵ)
+#define BENCH_CYCLES()          (DWT->CYCCNT)
+
+// 
+#define BENCH_CYCLES_TO_NS(c)   ((uint32_t)(((uint64_t)(c) * 1000u) / (SystemCoreClock / 1000000u)))
+
+// һͳ (֮ǰ)
+typedef struct
+{
+    uint64_t sum;           // 
+    uint32_t count;         // 
+    uint32_t max;           // һ
+} bench_stat_t;
+
+// bench_loop õı⺯
+typedef void (*bench_fn_t)(void);
+
+void bench_start(void);
+void bench_begin(const char *title);
+task_tcb* bench_spawn(void *task_function, char *task_name, uint32_t task_priority);
+void bench_sleep_until(uint32_t tick);
+void bench_busy(uint32_t us);
+void bench_stat_add(bench_stat_t *st, uint32_t cycles);
+void bench_loop(bench_stat_t *st, bench_fn_t fn, uint32_t loops);
+void bench_measure(const char *name, bench_fn_t fn, uint32_t loops);
+void bench_report(const char *name, uint64_t cycles, uint32_t count);
+void bench_report_stat(const char *name, const bench_stat_t *st);
+void bench_report_rate(uint32_t count, uint32_t cycles, const char *unit);
+void bench_report_ratio(uint32_t num, uint32_t den, const char *what);
+void bench_finish(void);
+void bench_park(void);
+
+void bench_tick_isr_start(void);
+void bench_prio_lookup_start(void);
+void bench_inversion_start(void);
+void bench_threshold_start(void);
+void bench_sched_start(void);
+void bench_irq_latency_start(void);
+void bench_switch_start(void);
+void bench_fpu_start(void);
+void bench_isr_yield_start(void);
+void bench_sem_start(void);
+void bench_timeout_race_start(void);
+void bench_queue_start(void);
+void bench_ringbuf_start(void);
+void bench_stream_start(void);
+void bench_notify_start(void);
+void bench_mem_start(void);
+
+#endif
@@ -0,0 +1,107 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "stm32f4xx.h"
+#include "task.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+//  vs л
+//  BENCH_SWITCH лһL ٽ H ź˳ٽʱе HH ʱ
+// һԲ FPUPendSV ֻ R4-R11һ (TASK_OPT_FPU) ÿһֶһ¸㣬
+// лʱ FPCA λPendSV Ҫ S16-S31Ӳѹջٴ S0-S15  FPSCR
+// ============================================================
+#define FPU_LOOPS           1000
+
+#define FPU_PRIO_H          (BENCH_PRIORITY - 1)
+#define FPU_PRIO_L          (BENCH_PRIORITY - 2)
+
+typedef struct
+{
+    sem_t *wake;            // L -> Hйȥ
+    sem_t *go;              //  -> Lʼ
+    sem_t *done;            // H -> 
+    volatile uint32_t t0;
+    bench_stat_t stat;
+    volatile float acc;     // ø㲻Ż
+} fpu_pair_t;
+
+static fpu_pair_t fpu_pair[2]; // [0] [1] 
+
+static void fpu_h_body(fpu_pair_t *p, uint32_t use_fpu)
+{
+    uint32_t i;
+    float x = 1.0f;
+
+    for (i = 0; i < FPU_LOOPS; i++)
+    {
+        sem_take(p->wake);
+        bench_stat_add(&p->stat, BENCH_CYCLES() - p->t0);
+
+        if (use_fpu) x = x * 1.0001f + 0.5f; // һ FPU´ʱиֳҪ
+    }
+    p->acc = x;
+    sem_give(p->done);
+    bench_park();
+}
+
+static void fpu_l_body(fpu_pair_t *p, uint32_t use_fpu)
+{
+    uint32_t i;
+    float x = 1.0f;
+
+    sem_take(p->go);
+
+    for (i = 0; i < FPU_LOOPS; i++)
+    {
+        if (use_fpu) x = x * 0.9999f + 0.25f;
+
+        task_enter_critical();
+        sem_give(p->wake);
+        p->t0 = BENCH_CYCLES();
+        task_exit_critical();
+    }
+    p->acc = x;
+    bench_park();
+}
+
+static void fpu_int_h(void) { fpu_h_body(&fpu_pair[0], 0); }
+static void fpu_int_l(void) { fpu_l_body(&fpu_pair[0], 0); }
+static void fpu_fp_h(void)  { fpu_h_body(&fpu_pair[1], 1); }
+static void fpu_fp_l(void)  { fpu_l_body(&fpu_pair[1], 1); }
+
+static void fpu_run(const char *name, fpu_pair_t *p)
+{
+    sem_give(p->go);
+    sem_take(p->done);
+
+    bench_report_stat(name, &p->stat);
+}
+
+static void fpu_bench_task(void)
+{
+    bench_begin("task switch cost, integer vs FPU");
+
+    fpu_run("switch, integer tasks", &fpu_pair[0]);
+    fpu_run("switch, FPU tasks", &fpu_pair[1]);
+
+    bench_finish();
+}
+
+void bench_fpu_start(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        fpu_pair[i].wake = sem_create(0);
+        fpu_pair[i].go = sem_create(0);
+        fpu_pair[i].done = sem_create(0);
+    }
+
+    bench_spawn((void *)fpu_bench_task, "b_fpu", BENCH_PRIORITY);
+    bench_spawn((void *)fpu_int_h, "b_int_h", FPU_PRIO_H);
+    bench_spawn((void *)fpu_int_l, "b_int_l", FPU_PRIO_L);
+    task_create_ex((void *)fpu_fp_h, BENCH_STACK_DEPTH, "b_fp_h", FPU_PRIO_H, TASK_OPT_FPU);
+    task_create_ex((void *)fpu_fp_l, BENCH_STACK_DEPTH, "b_fp_l", FPU_PRIO_L, TASK_OPT_FPU);
+}
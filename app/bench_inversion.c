@@ -0,0 +1,144 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "os_delay.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ȼתȼʱ䣬ź vs 
+// ÿһ (INV_PERIOD  Tick)
+//    0  Tickȼ L  INV_L_WORK_US Ļ
+//    1  Tickȼ H Ҫ L סͬʱȼ M  INV_M_WORK_US Ļ
+// źûм̳УL  M ռH Ҫһ M ꣻ L ʱ H ȼ
+// H ֻ L ʣµǵ (ļ̳Ҫ OS_MUTEX_INHERIT_ENABLE)
+//
+// ٲһʽ̳еĳʱˣL  far ˯ţM  near ȥ far
+// H ʱ nearH ȵʱ ML ᵽ H ȼH ʱԺҪԭʼȼ
+// ============================================================
+#define INV_ROUNDS          20      // ÿܶ
+#define INV_PERIOD          10      // һֶٸ Tick
+#define INV_L_WORK_US       2000    // L ɶ
+#define INV_M_WORK_US       5000    // M ɶ
+#define INV_CHAIN_TIMEOUT   5       // ʽһ H ȶ (Tick)
+
+#define INV_PRIO_H          (BENCH_PRIORITY - 1)
+#define INV_PRIO_M          (BENCH_PRIORITY - 2)
+#define INV_PRIO_L          (BENCH_PRIORITY - 3)
+
+static sem_t *inv_sem;
+static mutex_t *inv_mutex;
+static uint32_t inv_base;   // һֿʼ Tick
+static uint32_t inv_chain;  // ʽʱһοʼ Tick
+
+static mutex_t *inv_far;    // L 
+static mutex_t *inv_near;   // M ţM ڵ inv_far
+static sem_t *inv_release;  // H ˣ L 
+static task_tcb *inv_tcb_m;
+static task_tcb *inv_tcb_l;
+
+// ǰ INV_ROUNDS źû
+static void inv_lock(uint32_t round)
+{
+    if (round < INV_ROUNDS) sem_take(inv_sem);
+    else mutex_lock(inv_mutex);
+}
+
+static void inv_unlock(uint32_t round)
+{
+    if (round < INV_ROUNDS) sem_give(inv_sem);
+    else mutex_unlock(inv_mutex);
+}
+
+static void inv_task_l(void)
+{
+    uint32_t round;
+
+    for (round = 0; round < 2 * INV_ROUNDS; round++)
+    {
+        bench_sleep_until(inv_base + round * INV_PERIOD);
+        inv_lock(round);
+        bench_busy(INV_L_WORK_US);
+        inv_unlock(round);
+    }
+
+    // Զˣ far һֱ˯ H 
+    bench_sleep_until(inv_chain);
+    mutex_lock(inv_far);
+    sem_take(inv_release);
+    mutex_unlock(inv_far);
+    bench_park();
+}
+
+static void inv_task_m(void)
+{
+    uint32_t round;
+
+    for (round = 0; round < 2 * INV_ROUNDS; round++)
+    {
+        bench_sleep_until(inv_base + round * INV_PERIOD + 1);
+        bench_busy(INV_M_WORK_US);
+    }
+
+    // м䣺 near ȥ far
+    bench_sleep_until(inv_chain + 1);
+    mutex_lock(inv_near);
+    mutex_lock(inv_far);
+    mutex_unlock(inv_far);
+    mutex_unlock(inv_near);
+    bench_park();
+}
+
+static void inv_task_h(void)
+{
+    bench_stat_t st[2] = {{0, 0, 0}, {0, 0, 0}};
+    uint32_t round, t0, m_prio, l_prio;
+    int result;
+
+    bench_begin("priority inversion, H blocking time");
+
+    for (round = 0; round < 2 * INV_ROUNDS; round++)
+    {
+        bench_sleep_until(inv_base + round * INV_PERIOD + 1);
+
+        t0 = BENCH_CYCLES();
+        inv_lock(round);
+        bench_stat_add(&st[round < INV_ROUNDS ? 0 : 1], BENCH_CYCLES() - t0);
+        inv_unlock(round);
+    }
+
+    // ʽʱH ʱԺM  L ٶ H ȼ
+    // (ٴӡռס CPU ü Tick)
+    bench_sleep_until(inv_chain + 2);
+    result = mutex_lock_timeout(inv_near, INV_CHAIN_TIMEOUT);
+    m_prio = inv_tcb_m->task_priority;
+    l_prio = inv_tcb_l->task_priority;
+    sem_give(inv_release);
+
+    bench_report_stat("H blocked, sem (no inherit)", &st[0]);
+    bench_report_stat("H blocked, mutex (inherit)", &st[1]);
+
+    printf("[bench] chained timeout: %s, M prio %u (base %u), L prio %u (base %u) -> %s\r\n",
+           (result == OS_ERR_TIMEOUT) ? "timed out" : "not timed out",
+           (unsigned)m_prio, (unsigned)inv_tcb_m->base_priority,
+           (unsigned)l_prio, (unsigned)inv_tcb_l->base_priority,
+           (result == OS_ERR_TIMEOUT && m_prio == inv_tcb_m->base_priority
+            && l_prio == inv_tcb_l->base_priority) ? "PASS" : "FAIL");
+
+    bench_finish();
+}
+
+void bench_inversion_start(void)
+{
+    inv_sem = sem_create(1);
+    inv_mutex = mutex_create();
+    inv_far = mutex_create();
+    inv_near = mutex_create();
+    inv_release = sem_create(0);
+    inv_base = os_get_tick() + 20;
+    inv_chain = inv_base + (2 * INV_ROUNDS + 1) * INV_PERIOD;
+
+    bench_spawn((void *)inv_task_h, "b_inv_h", INV_PRIO_H);
+    inv_tcb_m = bench_spawn((void *)inv_task_m, "b_inv_m", INV_PRIO_M);
+    inv_tcb_l = bench_spawn((void *)inv_task_l, "b_inv_l", INV_PRIO_L);
+}
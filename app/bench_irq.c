@@ -0,0 +1,135 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "stm32f4xx.h"
+#include "task.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ȼжϵӦӳ (IPC )ں BASEPRI vs ȫж
+// TIM2  IRQ_TIM_PERIOD ڲжϣNVIC ȼ 0 ( OS_MAX_SYSCALL_PRIORITY )
+// ж TIM2->CNT ǴӸ¼жϹ˶ٸʱʱ
+// һͣźշͻӽģʽ
+//   BASEPRIֱӵãںٽס TIM2
+//   ȫжϣÿεһ __disable_irq/__enable_irqģǰں __disable_irq ٽ
+// ============================================================
+#define IRQ_TIM_PERIOD      4200    // ʱʱ 84MHz50us һ
+#define IRQ_TIM_CLOCK_DIV   2       // CPU  / ʱʱ (APB1 ʱʱƵһ)
+#define IRQ_RUN_TICKS       1000    // ÿģʽܶ
+
+#define IRQ_MODE_OFF        0
+#define IRQ_MODE_BASEPRI    1
+#define IRQ_MODE_DISABLE    2
+
+static volatile uint32_t irq_mode = IRQ_MODE_OFF;
+static bench_stat_t irq_stat;
+
+static sem_t *irq_sem;
+static mutex_t *irq_mutex;
+
+#if BENCH_SELECT == BENCH_IRQ_LATENCY
+void TIM2_IRQHandler(void)
+{
+    uint32_t lat = TIM2->CNT; // ȶԽԽ׼
+
+    TIM2->SR = (uint16_t)~TIM_SR_UIF;
+
+    if (irq_mode != IRQ_MODE_OFF)
+    {
+        bench_stat_add(&irq_stat, lat * IRQ_TIM_CLOCK_DIV);
+    }
+}
+#endif
+
+static void irq_timer_init(void)
+{
+    TIM_TimeBaseInitTypeDef tb;
+    NVIC_InitTypeDef nvic;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+
+    TIM_TimeBaseStructInit(&tb);
+    tb.TIM_Prescaler = 0;
+    tb.TIM_Period = IRQ_TIM_PERIOD - 1;
+    tb.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM2, &tb);
+    TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+    TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);
+
+    // ȼ 0ں˵ BASEPRI ٽס (start_scheduler Ѿ˷)
+    nvic.NVIC_IRQChannel = TIM2_IRQn;
+    nvic.NVIC_IRQChannelPreemptionPriority = 0;
+    nvic.NVIC_IRQChannelSubPriority = 0;
+    nvic.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&nvic);
+
+    TIM_Cmd(TIM2, ENABLE);
+}
+
+// IPC أźһһȡ + һһ⣬ٽ·
+static void irq_load_task(void)
+{
+    while (1)
+    {
+        if (irq_mode == IRQ_MODE_DISABLE)
+        {
+            __disable_irq();
+            sem_give(irq_sem);
+            __enable_irq();
+            __disable_irq();
+            sem_take(irq_sem);
+            __enable_irq();
+            __disable_irq();
+            mutex_lock(irq_mutex);
+            __enable_irq();
+            __disable_irq();
+            mutex_unlock(irq_mutex);
+            __enable_irq();
+        }
+        else
+        {
+            sem_give(irq_sem);
+            sem_take(irq_sem);
+            mutex_lock(irq_mutex);
+            mutex_unlock(irq_mutex);
+        }
+    }
+}
+
+static void irq_run(const char *name, uint32_t mode)
+{
+    bench_stat_t st;
+
+    irq_stat.sum = 0;
+    irq_stat.count = 0;
+    irq_stat.max = 0;
+    irq_mode = mode;
+
+    os_delay(IRQ_RUN_TICKS);
+
+    irq_mode = IRQ_MODE_OFF;
+    st = irq_stat;
+
+    bench_report_stat(name, &st);
+}
+
+static void irq_bench_task(void)
+{
+    bench_begin("top-priority irq latency under IPC load");
+    irq_timer_init();
+
+    irq_run("irq latency, BASEPRI", IRQ_MODE_BASEPRI);
+    irq_run("irq latency, __disable_irq", IRQ_MODE_DISABLE);
+
+    TIM_Cmd(TIM2, DISABLE);
+    bench_finish();
+}
+
+void bench_irq_latency_start(void)
+{
+    irq_sem = sem_create(0);
+    irq_mutex = mutex_create();
+
+    bench_spawn((void *)irq_bench_task, "b_irq", BENCH_PRIORITY);
+    bench_spawn((void *)irq_load_task, "b_irq_ld", BENCH_PRIORITY - 1);
+}
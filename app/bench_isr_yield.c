@@ -0,0 +1,107 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "stm32f4xx.h"
+#include "task.h"
+#include "scheduler.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ж﻽Ѷʱ PendSV
+// һж ( TIM3  NVIC 𴥷)  sem_give_from_isr ź
+// ȱϵȼߵڵȡ*_from_isr ֻһ"Ҫл"
+// os_isr_exit ˳ʱͳһһ PendSV
+// ÿжϣPendSV ϲ (ǰ API ÿλѶһ)
+// ʵлԼжϱ
+// ============================================================
+#define YIELD_ROUNDS        1000
+#define YIELD_WAITERS       3
+
+#define YIELD_IRQ           TIM3_IRQn
+#define YIELD_PRIO_TRIGGER  (BENCH_PRIORITY - YIELD_WAITERS - 1)
+
+static sem_t *yield_sem[YIELD_WAITERS];
+static bench_stat_t yield_isr_stat;
+
+#if BENCH_SELECT == BENCH_ISR_YIELD
+void TIM3_IRQHandler(void)
+{
+    uint32_t i, t0 = BENCH_CYCLES();
+
+    os_isr_enter();
+    for (i = 0; i < YIELD_WAITERS; i++)
+    {
+        sem_give_from_isr(yield_sem[i]);
+    }
+    os_isr_exit();
+
+    bench_stat_add(&yield_isr_stat, BENCH_CYCLES() - t0);
+}
+#endif
+
+static void yield_waiter(uint32_t idx)
+{
+    while (1)
+    {
+        sem_take(yield_sem[idx]);
+    }
+}
+
+static void yield_waiter0(void) { yield_waiter(0); }
+static void yield_waiter1(void) { yield_waiter(1); }
+static void yield_waiter2(void) { yield_waiter(2); }
+
+// жϵȼȴ߶ͣ˾͵йȥ
+static void yield_trigger_task(void)
+{
+    uint32_t i, exits, pendsvs, coalesced, switches;
+
+    bench_begin("isr waking several tasks, pendsv per isr");
+
+    // Եں API жϣȼܱ OS_MAX_SYSCALL_PRIORITY 
+    NVIC_SetPriority(YIELD_IRQ, OS_MAX_SYSCALL_PRIORITY + 1);
+    NVIC_EnableIRQ(YIELD_IRQ);
+
+    exits = os_isr_exit_count;
+    pendsvs = os_isr_pendsv_count;
+    coalesced = os_yield_coalesced;
+    switches = os_switch_count;
+
+    for (i = 0; i < YIELD_ROUNDS; i++)
+    {
+        NVIC_SetPendingIRQ(YIELD_IRQ);
+        __DSB();
+        __ISB();
+        // жѾ꣬ȴҲܹһ˯ȥ
+    }
+
+    exits = os_isr_exit_count - exits;
+    pendsvs = os_isr_pendsv_count - pendsvs;
+    coalesced = os_yield_coalesced - coalesced;
+    switches = os_switch_count - switches;
+
+    NVIC_DisableIRQ(YIELD_IRQ);
+
+    bench_report_stat("isr, 3x sem_give_from_isr", &yield_isr_stat);
+    bench_report_ratio(pendsvs, YIELD_ROUNDS, "pendsv per isr");
+    bench_report_ratio(coalesced, YIELD_ROUNDS, "coalesced requests per isr");
+    bench_report_ratio(switches, YIELD_ROUNDS, "switches per isr");
+    bench_report_ratio(exits, YIELD_ROUNDS, "outermost isr exits per isr (SysTick included)");
+
+    bench_finish();
+}
+
+void bench_isr_yield_start(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < YIELD_WAITERS; i++)
+    {
+        yield_sem[i] = sem_create(0);
+    }
+
+    bench_spawn((void *)yield_waiter0, "b_yw0", BENCH_PRIORITY - 1);
+    bench_spawn((void *)yield_waiter1, "b_yw1", BENCH_PRIORITY - 2);
+    bench_spawn((void *)yield_waiter2, "b_yw2", BENCH_PRIORITY - 3);
+    bench_spawn((void *)yield_trigger_task, "b_ytrg", YIELD_PRIO_TRIGGER);
+}
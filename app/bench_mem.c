@@ -0,0 +1,71 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "task.h"
+#include "mem_pool.h"
+#include "bench.h"
+
+// ============================================================
+// ڴ vs malloc/freeÿ + ͷŵ (ƽ)
+// ǳʱ䣻Ҫҿп顢ϲʱƬйأ
+// Զٲһ"Ƭ֮" (һСһĿ飬һͷһ)
+// ============================================================
+#define MEM_BENCH_LOOPS     2000
+#define MEM_BENCH_BLOCK     64
+#define MEM_BENCH_FRAG      32
+
+static uint64_t mem_pool_mem[MEM_POOL_WORDS(MEM_BENCH_BLOCK, 16)];
+static mem_pool_t mem_bench_pool;
+
+static void mem_pool_cycle(void)
+{
+    mem_pool_free(&mem_bench_pool, mem_pool_alloc(&mem_bench_pool));
+}
+
+static void os_mem_cycle(void)
+{
+    os_mem_free(os_mem_alloc(MEM_BENCH_BLOCK));
+}
+
+static void mem_heap_cycle(void)
+{
+    free(malloc(MEM_BENCH_BLOCK));
+}
+
+static void mem_bench_task(void)
+{
+    void *frag[MEM_BENCH_FRAG];
+    uint32_t i;
+
+    bench_begin("fixed-block pool vs heap");
+    mem_pool_init(&mem_bench_pool, "bench", mem_pool_mem, MEM_BENCH_BLOCK, 16);
+
+    bench_measure("mem_pool alloc+free", mem_pool_cycle, MEM_BENCH_LOOPS);
+    bench_measure("os_mem alloc+free", os_mem_cycle, MEM_BENCH_LOOPS);
+    bench_measure("malloc+free, clean heap", mem_heap_cycle, MEM_BENCH_LOOPS);
+
+    // ѶŪ飺Сһһһͷһ
+    for (i = 0; i < MEM_BENCH_FRAG; i++)
+    {
+        frag[i] = malloc(16 + (i * 24) % 200);
+    }
+    for (i = 0; i < MEM_BENCH_FRAG; i += 2)
+    {
+        free(frag[i]);
+        frag[i] = NULL;
+    }
+
+    bench_measure("malloc+free, fragmented", mem_heap_cycle, MEM_BENCH_LOOPS);
+
+    for (i = 0; i < MEM_BENCH_FRAG; i++)
+    {
+        free(frag[i]);
+    }
+
+    bench_finish();
+}
+
+void bench_mem_start(void)
+{
+    bench_spawn((void *)mem_bench_task, "b_mem", BENCH_PRIORITY);
+}
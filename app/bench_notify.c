@@ -0,0 +1,104 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "scheduler.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ֪ͨź vs ź
+// 1. һһȡ (л)task_notify_ex(INCREMENT) + task_notify_take vs sem_give + sem_take
+// 2. ȼߵĵȴڵȣһξйȥһΣÿ" -> Էõ -> л"
+// RAMһź sizeof(sem_t) ֽڣ֪ͨ TCB ֳɵĲۣռ
+// ============================================================
+#define NOTIFY_BENCH_LOOPS  10000
+
+#define NOTIFY_PRIO_WAITER  (BENCH_PRIORITY - 1)
+#define NOTIFY_PRIO_GIVER   (BENCH_PRIORITY - 2)
+
+static sem_t *notify_sem;
+static sem_t *notify_done;
+static sem_t *notify_local_sem;     // һһȡ
+static task_tcb *notify_waiter_tcb;
+
+static void notify_sem_waiter(void)
+{
+    uint32_t i;
+
+    while (1)
+    {
+        for (i = 0; i < NOTIFY_BENCH_LOOPS; i++)
+        {
+            sem_take(notify_sem);
+        }
+        sem_give(notify_done);
+    }
+}
+
+static void notify_waiter(void)
+{
+    uint32_t i;
+
+    while (1)
+    {
+        for (i = 0; i < NOTIFY_BENCH_LOOPS; i++)
+        {
+            task_notify_take(0, 0, NULL, OS_WAIT_FOREVER);
+        }
+        sem_give(notify_done);
+    }
+}
+
+static void notify_sem_pair(void)
+{
+    sem_give(notify_local_sem);
+    sem_take(notify_local_sem);
+}
+
+static void notify_pair(void)
+{
+    task_notify_ex(current_tcb, 0, 0, NOTIFY_ACTION_INCREMENT);
+    task_notify_take(0, 0, NULL, OS_NO_WAIT);
+}
+
+static void notify_bench_task(void)
+{
+    uint32_t i, t0;
+
+    bench_begin("notification as semaphore vs semaphore");
+    printf("[bench] sizeof(sem_t) = %u bytes\r\n", (unsigned)sizeof(sem_t));
+
+    // 1. 
+    bench_measure("sem give+take, no switch", notify_sem_pair, NOTIFY_BENCH_LOOPS);
+    bench_measure("notify inc+take, no switch", notify_pair, NOTIFY_BENCH_LOOPS);
+
+    // 2. 
+    t0 = BENCH_CYCLES();
+    for (i = 0; i < NOTIFY_BENCH_LOOPS; i++)
+    {
+        sem_give(notify_sem);
+    }
+    sem_take(notify_done);
+    bench_report("sem give -> waiter", BENCH_CYCLES() - t0, NOTIFY_BENCH_LOOPS);
+
+    t0 = BENCH_CYCLES();
+    for (i = 0; i < NOTIFY_BENCH_LOOPS; i++)
+    {
+        task_notify_ex(notify_waiter_tcb, 0, 0, NOTIFY_ACTION_INCREMENT);
+    }
+    sem_take(notify_done);
+    bench_report("notify inc -> waiter", BENCH_CYCLES() - t0, NOTIFY_BENCH_LOOPS);
+
+    bench_finish();
+}
+
+void bench_notify_start(void)
+{
+    notify_sem = sem_create(0);
+    notify_done = sem_create(0);
+    notify_local_sem = sem_create(0);
+
+    bench_spawn((void *)notify_bench_task, "b_ntf", NOTIFY_PRIO_GIVER);
+    bench_spawn((void *)notify_sem_waiter, "b_ntf_s", NOTIFY_PRIO_WAITER);
+    notify_waiter_tcb = bench_spawn((void *)notify_waiter, "b_ntf_n", NOTIFY_PRIO_WAITER);
+}
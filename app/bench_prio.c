@@ -0,0 +1,99 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "scheduler.h"
+#include "bench.h"
+
+// ============================================================
+// ȼҵĺʱ vs ȼλ / ȼ
+// ٽλͼֻһȼֱλͼ (get_highest_priority)
+// ʹӸɨĺʱǰӦƽģȼ
+//  os_config.h  MAX_PRIORITY (32/256/1024) ±룬ԱȲͬļ
+// ============================================================
+#define PRIO_BENCH_LOOPS    1000
+
+extern uint32_t PrioGroup;
+extern uint32_t PrioBitmap[PRIO_GROUP_COUNT];
+
+static const uint32_t prio_points[] = {1, 32, 100, 256, 511};
+
+static volatile uint32_t prio_sink;
+
+static void prio_lookup_bitmap(void)
+{
+    prio_sink = get_highest_priority();
+}
+
+// 飺λͼ飬ȼһһ
+static void prio_lookup_scan(void)
+{
+    int32_t p;
+
+    for (p = MAX_PRIORITY - 1; p > 0; p--)
+    {
+        if (PrioBitmap[p >> 5] & (1u << (p & 31))) break;
+    }
+    prio_sink = (uint32_t)p;
+}
+
+static void prio_measure(uint32_t prio)
+{
+    uint32_t saved_group, saved_map[PRIO_GROUP_COUNT];
+    bench_stat_t bitmap = {0, 0, 0}, scan = {0, 0, 0};
+    uint32_t i;
+    char name[32];
+
+    task_enter_critical();
+
+    // 1. ֻ prio һλͼ
+    saved_group = PrioGroup;
+    for (i = 0; i < PRIO_GROUP_COUNT; i++)
+    {
+        saved_map[i] = PrioBitmap[i];
+        PrioBitmap[i] = 0;
+    }
+    PrioGroup = 1u << (prio >> 5);
+    PrioBitmap[prio >> 5] = 1u << (prio & 31);
+
+    // 2. ֲ鷨 PRIO_BENCH_LOOPS 
+    bench_loop(&bitmap, prio_lookup_bitmap, PRIO_BENCH_LOOPS);
+    bench_loop(&scan, prio_lookup_scan, PRIO_BENCH_LOOPS);
+
+    // 3. ԭ
+    PrioGroup = saved_group;
+    for (i = 0; i < PRIO_GROUP_COUNT; i++)
+    {
+        PrioBitmap[i] = saved_map[i];
+    }
+
+    task_exit_critical();
+
+    sprintf(name, "bitmap lookup, prio %u", (unsigned)prio);
+    bench_report_stat(name, &bitmap);
+    sprintf(name, "linear scan,   prio %u", (unsigned)prio);
+    bench_report_stat(name, &scan);
+}
+
+static void prio_bench_task(void)
+{
+    uint32_t k;
+
+    bench_begin("highest ready priority lookup");
+    printf("[bench] MAX_PRIORITY = %u\r\n", (unsigned)MAX_PRIORITY);
+
+    for (k = 0; k < sizeof(prio_points) / sizeof(prio_points[0]); k++)
+    {
+        if (prio_points[k] < MAX_PRIORITY)
+        {
+            prio_measure(prio_points[k]);
+        }
+    }
+    prio_measure(MAX_PRIORITY - 1);
+
+    bench_finish();
+}
+
+void bench_prio_lookup_start(void)
+{
+    bench_spawn((void *)prio_bench_task, "b_prio", BENCH_PRIORITY);
+}
@@ -0,0 +1,135 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ϢϢ vs 
+// 1. һһ (л)ÿԲ
+// 2. ߷ MSGQ_COUNT գ
+//    ֻһۣȼ߸ (ᱻ)ÿϢ
+//    ͬȼϵһΣȼһһ (˲У)
+// ============================================================
+#define MSGQ_COUNT          10000
+#define MSGQ_LEN            16
+
+#define MSGQ_PRIO_HI        (BENCH_PRIORITY - 1)   // ߸ߵ
+#define MSGQ_PRIO_PROD      (BENCH_PRIORITY - 2)   //  (Լ)
+#define MSGQ_PRIO_LO        (BENCH_PRIORITY - 3)   // ߵ͵
+
+static mailbox_t *msgq_mbox;
+static queue_t *msgq_queue_hi;
+static queue_t *msgq_queue_lo;
+static sem_t *msgq_done;
+static mailbox_t *msgq_mbox_local;  // һһ
+static queue_t *msgq_queue_local;
+
+static void msgq_mbox_consumer(void)
+{
+    uint32_t i;
+
+    while (1)
+    {
+        for (i = 0; i < MSGQ_COUNT; i++)
+        {
+            (void)mbox_fetch(msgq_mbox);
+        }
+        sem_give(msgq_done);
+    }
+}
+
+static void msgq_queue_consume(queue_t *q)
+{
+    uint32_t i, item;
+
+    while (1)
+    {
+        for (i = 0; i < MSGQ_COUNT; i++)
+        {
+            queue_recv(q, &item, OS_WAIT_FOREVER);
+        }
+        sem_give(msgq_done);
+    }
+}
+
+static void msgq_queue_consumer_hi(void) { msgq_queue_consume(msgq_queue_hi); }
+static void msgq_queue_consumer_lo(void) { msgq_queue_consume(msgq_queue_lo); }
+
+static void msgq_report(const char *name, uint32_t cycles)
+{
+    bench_report(name, cycles, MSGQ_COUNT);
+    bench_report_rate(MSGQ_COUNT, cycles, "msgs");
+}
+
+static void msgq_mbox_pair(void)
+{
+    void *msg;
+
+    mbox_post(msgq_mbox_local, (void *)1);
+    mbox_fetch_timeout(msgq_mbox_local, &msg, OS_NO_WAIT);
+}
+
+static void msgq_queue_pair(void)
+{
+    uint32_t item = 1;
+
+    queue_send(msgq_queue_local, &item, OS_NO_WAIT);
+    queue_recv(msgq_queue_local, &item, OS_NO_WAIT);
+}
+
+//  (Լ)  MSGQ_COUNT 
+static void msgq_run_mbox(const char *name)
+{
+    uint32_t i, t0 = BENCH_CYCLES();
+
+    for (i = 0; i < MSGQ_COUNT; i++)
+    {
+        mbox_post(msgq_mbox, (void *)i);
+    }
+    sem_take(msgq_done);
+    msgq_report(name, BENCH_CYCLES() - t0);
+}
+
+static void msgq_run_queue(const char *name, queue_t *q)
+{
+    uint32_t i, t0 = BENCH_CYCLES();
+
+    for (i = 0; i < MSGQ_COUNT; i++)
+    {
+        queue_send(q, &i, OS_WAIT_FOREVER);
+    }
+    sem_take(msgq_done);
+    msgq_report(name, BENCH_CYCLES() - t0);
+}
+
+static void msgq_bench_task(void)
+{
+    bench_begin("message throughput, queue vs mailbox");
+
+    // 1. һһ
+    bench_measure("mbox post+fetch, no switch", msgq_mbox_pair, MSGQ_COUNT);
+    bench_measure("queue send+recv, no switch", msgq_queue_pair, MSGQ_COUNT);
+
+    // 2. 
+    msgq_run_mbox("mbox, consumer higher");
+    msgq_run_queue("queue, consumer higher", msgq_queue_hi);
+    msgq_run_queue("queue, consumer lower", msgq_queue_lo);
+
+    bench_finish();
+}
+
+void bench_queue_start(void)
+{
+    msgq_mbox = mbox_create();
+    msgq_queue_hi = queue_create(MSGQ_LEN, sizeof(uint32_t));
+    msgq_queue_lo = queue_create(MSGQ_LEN, sizeof(uint32_t));
+    msgq_done = sem_create(0);
+    msgq_mbox_local = mbox_create();
+    msgq_queue_local = queue_create(MSGQ_LEN, sizeof(uint32_t));
+
+    bench_spawn((void *)msgq_bench_task, "b_msgq", MSGQ_PRIO_PROD);
+    bench_spawn((void *)msgq_mbox_consumer, "b_msgq_m", MSGQ_PRIO_HI);
+    bench_spawn((void *)msgq_queue_consumer_hi, "b_msgq_h", MSGQ_PRIO_HI);
+    bench_spawn((void *)msgq_queue_consumer_lo, "b_msgq_l", MSGQ_PRIO_LO);
+}
@@ -0,0 +1,110 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "scheduler.h"
+#include "event.h"
+#include "os_delay.h"
+#include "cpu_tick.h"
+#include "bench.h"
+
+// ============================================================
+// ʱͷײͬһ Tick ϣsem_take_timeout ĽźļԵ
+//   õ OS_OK      -> ԴѾˣ 0
+//   õ OS_ERR_TIMEOUT -> Ǵͷź 1
+// Ͼظ (OK  1) ߶ͷ (ʱ 0)
+// ײ
+//   A. SysTick os_tick_handler ֮ǰsem_give_from_isr (ͷȵ)
+//   B. ȼ G ʱͬһ Tick͵ȴߵĳʱһ𱻻ѣ sem_give (ʱȵ)
+// ============================================================
+#define RACE_ROUNDS         1000
+#define RACE_TIMEOUT        3       // ȴߵĳʱ (Tick)
+
+#define RACE_PRIO_G         (BENCH_PRIORITY - 1)
+#define RACE_PRIO_W         (BENCH_PRIORITY - 2)
+
+static sem_t *race_sem;
+static task_tcb *race_g_tcb;
+static volatile uint32_t race_isr_tick;     // ASysTick ߵ Tick ֮ǰͷ (0 = ͷ)
+
+// SysTick_Handler os_tick_handler ֮ǰ (ʱ os_get_tick һ Tick)
+static void race_tick_callback(void)
+{
+    if (race_isr_tick != 0 && os_get_tick() + 1 == race_isr_tick)
+    {
+        race_isr_tick = 0;
+        os_isr_enter();
+        sem_give_from_isr(race_sem);
+        os_isr_exit();
+    }
+}
+
+// BյĿ Tick˯Ǹ Tick ͷ
+static void race_giver_task(void)
+{
+    while (1)
+    {
+        bench_sleep_until(task_wait_notify());
+        sem_give(race_sem);
+    }
+}
+
+static void race_waiter_task(void)
+{
+    uint32_t round, t, wake, count;
+    uint32_t got_ok = 0, got_timeout = 0, doubled = 0, lost = 0;
+    sem_info_t info;
+    int ret;
+
+    bench_begin("give/timeout race on the same tick");
+    cpu_register_periodic_callback(race_tick_callback);
+
+    for (round = 0; round < RACE_ROUNDS; round++)
+    {
+        // 1. չһ Tick ʱʼ⼸϶ͬһ Tick 
+        t = os_get_tick();
+        while (os_get_tick() == t);
+        wake = os_get_tick() + RACE_TIMEOUT;
+
+        // 2. һͷţڳʱǸ Tick 
+        if (round & 1) task_notify(race_g_tcb, wake); // G ȼߣȥ˯ wake
+        else race_isr_tick = wake;
+
+        // 3. 
+        ret = sem_take_timeout(race_sem, RACE_TIMEOUT);
+
+        // 4.  G Ҳ (ȼߣ)ٶ
+        sem_get_info(race_sem, &info);
+        count = info.current_count;
+
+        if (ret == OS_OK)
+        {
+            got_ok++;
+            if (count != 0) doubled++;
+        }
+        else
+        {
+            got_timeout++;
+            if (count != 1) lost++;
+        }
+
+        // 5. źǴͷȡߣһִ 0 ʼ
+        while (sem_take_timeout(race_sem, OS_NO_WAIT) == OS_OK);
+    }
+
+    cpu_register_periodic_callback(NULL);
+
+    printf("[bench] give/timeout race: %u rounds, %u ok, %u timeout\r\n",
+           (unsigned)RACE_ROUNDS, (unsigned)got_ok, (unsigned)got_timeout);
+    printf("[bench]   double delivery %u, lost give %u -> %s\r\n",
+           (unsigned)doubled, (unsigned)lost, (doubled == 0 && lost == 0) ? "PASS" : "FAIL");
+
+    bench_finish();
+}
+
+void bench_timeout_race_start(void)
+{
+    race_sem = sem_create(0);
+
+    race_g_tcb = bench_spawn((void *)race_giver_task, "b_race_g", RACE_PRIO_G);
+    bench_spawn((void *)race_waiter_task, "b_race_w", RACE_PRIO_W);
+}
@@ -0,0 +1,98 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "event.h"
+#include "ringbuf.h"
+#include "bench.h"
+
+// ============================================================
+// λ
+// /ADC жһһ 1 ֽڣDMA жһһ飺ֱÿֽд + 
+//  KB/s (ֻ㻺Ŀ)ٽ queue_send_from_isr (1 ֽһ)
+// дͶٽҲжʱʱ
+// ============================================================
+#define RB_BENCH_BYTES      65536
+#define RB_BENCH_SIZE       1024
+#define RB_BENCH_CHUNK      64
+
+static uint8_t rb_mem[RB_BENCH_SIZE];
+static ringbuf_t rb;
+static queue_t *rb_queue;
+static uint8_t rb_chunk[RB_BENCH_CHUNK];
+static uint8_t rb_byte;
+
+static void rb_spsc_byte(void)
+{
+    ringbuf_write(&rb, &rb_byte, 1);
+    ringbuf_read(&rb, &rb_byte, 1);
+}
+
+static void rb_spsc_chunk(void)
+{
+    ringbuf_write(&rb, rb_chunk, RB_BENCH_CHUNK);
+    ringbuf_read(&rb, rb_chunk, RB_BENCH_CHUNK);
+}
+
+static void rb_mpsc_byte(void)
+{
+    ringbuf_mp_write(&rb, &rb_byte, 1);
+    ringbuf_read(&rb, &rb_byte, 1);
+}
+
+// ԭԤһύ (DMA ֱд÷)
+static void rb_mpsc_reserve(void)
+{
+    ringbuf_span_t span;
+
+    if (ringbuf_mp_reserve(&rb, RB_BENCH_CHUNK, &span) == OS_OK)
+    {
+        ringbuf_mp_commit(&rb);
+    }
+    ringbuf_read(&rb, rb_chunk, RB_BENCH_CHUNK);
+}
+
+static void rb_queue_byte(void)
+{
+    queue_send_from_isr(rb_queue, &rb_byte);
+    queue_recv(rb_queue, &rb_byte, OS_NO_WAIT);
+}
+
+// ÿεð bytes ֽڣһ RB_BENCH_BYTES ÿֽڵ
+static void rb_run(const char *name, bench_fn_t fn, uint32_t bytes)
+{
+    bench_stat_t st = {0, 0, 0};
+
+    bench_loop(&st, fn, RB_BENCH_BYTES / bytes);
+    bench_report(name, st.sum, RB_BENCH_BYTES);
+    bench_report_rate(RB_BENCH_BYTES / 1024u, (uint32_t)st.sum, "KB");
+}
+
+static void rb_bench_task(void)
+{
+    uint32_t i;
+
+    bench_begin("lock-free ring buffer throughput");
+    ringbuf_init(&rb, rb_mem, RB_BENCH_SIZE);
+
+    for (i = 0; i < RB_BENCH_CHUNK; i++)
+    {
+        rb_chunk[i] = (uint8_t)i;
+    }
+
+    rb_run("spsc write+read, 1 byte", rb_spsc_byte, 1);
+    rb_run("spsc write+read, 64 bytes", rb_spsc_chunk, RB_BENCH_CHUNK);
+    rb_run("mpsc write+read, 1 byte", rb_mpsc_byte, 1);
+    rb_run("mpsc reserve+commit, 64 bytes", rb_mpsc_reserve, RB_BENCH_CHUNK);
+
+    // գٽĶУһ 1 ֽ
+    rb_run("queue from_isr+recv, 1 byte", rb_queue_byte, 1);
+
+    bench_finish();
+}
+
+void bench_ringbuf_start(void)
+{
+    rb_queue = queue_create(16, 1);
+
+    bench_spawn((void *)rb_bench_task, "b_rb", BENCH_PRIORITY);
+}
@@ -0,0 +1,137 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "os_delay.h"
+#include "bench.h"
+
+// ============================================================
+// EDF vs  (RM)ͬһڲͬ´ֹʱĴ
+//  5ms / 7msֹʱڣÿһǵĻ
+//   RM (ڶ̵ȼ) Լ 83% Ϳʼ (ڶӦʱ䳬 7ms)
+//   EDF һֱӽ 100% 
+// ͬʱãͬһʱֻһڸɻһÿһ¾˯ (΢)
+// ֹʱԼˣͷʱ̴ 0 ʼÿڼһڣ
+// ʱѾͷʱ + ڣһ
+// ============================================================
+#define SCHED_LEVELS        4
+#define SCHED_RUN_TICKS     2000    // ÿһܶ
+#define SCHED_WARMUP_TICKS  20      // ֮һͳ
+
+#define SCHED_EDF           0
+#define SCHED_RM            1
+#define SCHED_IDLE          2
+
+// RM  EDF Ƶ棬ڶ̵ȼ
+#define SCHED_PRIO_RM0      (OS_EDF_PRIORITY - 1)
+#define SCHED_PRIO_RM1      (OS_EDF_PRIORITY - 2)
+
+static const uint32_t sched_period[2] = {5, 7};
+
+// ÿһÿڸɶ΢Ļ
+static const uint32_t sched_work_us[SCHED_LEVELS][2] =
+{
+    {1500, 2500},   // 65.7%
+    {1750, 3250},   // 81.4%
+    {2000, 3500},   // 90.0%
+    {2000, 4000},   // 97.1%
+};
+
+typedef struct
+{
+    volatile uint32_t jobs;         // ˶ٸڵĻ
+    volatile uint32_t miss;         // дֹʱ
+    volatile uint32_t late_max;     // ˼ Tick
+} sched_stat_t;
+
+static volatile uint32_t sched_phase = SCHED_IDLE;
+static volatile uint32_t sched_level;
+static sched_stat_t sched_stat[2][2];   // [][]
+
+static void sched_task(uint32_t policy, uint32_t idx)
+{
+    sched_stat_t *st = &sched_stat[policy][idx];
+    uint32_t release = 0;   // ֮ǰãһڴ Tick 0 ʼ
+    int32_t late;
+
+    while (1)
+    {
+        if (sched_phase == policy)
+        {
+            bench_busy(sched_work_us[sched_level][idx]);
+
+            late = (int32_t)(os_get_tick() - (release + sched_period[idx]));
+            st->jobs++;
+            if (late > 0)
+            {
+                st->miss++;
+                if ((uint32_t)late > st->late_max) st->late_max = (uint32_t)late;
+            }
+        }
+
+        // һ (EDF ںҲÿμһڣ˲)
+        release += sched_period[idx];
+        if (policy == SCHED_EDF) edf_wait_next_period();
+        else bench_sleep_until(release);
+    }
+}
+
+static void sched_edf_task0(void) { sched_task(SCHED_EDF, 0); }
+static void sched_edf_task1(void) { sched_task(SCHED_EDF, 1); }
+static void sched_rm_task0(void)  { sched_task(SCHED_RM, 0); }
+static void sched_rm_task1(void)  { sched_task(SCHED_RM, 1); }
+
+static void sched_run(uint32_t policy, uint32_t level)
+{
+    sched_stat_t *st = sched_stat[policy];
+    uint32_t util, i;
+
+    sched_level = level;
+    sched_phase = policy;
+    os_delay(SCHED_WARMUP_TICKS);
+
+    for (i = 0; i < 2; i++)
+    {
+        st[i].jobs = 0;
+        st[i].miss = 0;
+        st[i].late_max = 0;
+    }
+
+    os_delay(SCHED_RUN_TICKS);
+
+    //  (ǧ֮һ)
+    util = sched_work_us[level][0] / sched_period[0] + sched_work_us[level][1] / sched_period[1];
+
+    printf("[bench] %s U=%2u.%u%%  miss %u/%u + %u/%u  max late %u/%u ticks\r\n",
+           policy == SCHED_EDF ? "EDF" : "RM ",
+           (unsigned)(util / 10), (unsigned)(util % 10),
+           (unsigned)st[0].miss, (unsigned)st[0].jobs,
+           (unsigned)st[1].miss, (unsigned)st[1].jobs,
+           (unsigned)st[0].late_max, (unsigned)st[1].late_max);
+}
+
+static void sched_bench_task(void)
+{
+    uint32_t level;
+
+    bench_begin("EDF vs rate-monotonic, deadline misses");
+
+    for (level = 0; level < SCHED_LEVELS; level++)
+    {
+        sched_run(SCHED_EDF, level);
+        sched_run(SCHED_RM, level);
+    }
+    sched_phase = SCHED_IDLE;
+
+    bench_finish();
+}
+
+void bench_sched_start(void)
+{
+    // EDF Ľɲ԰صһ WCET (2/5 + 4/7 < 1)
+    task_create_edf((void *)sched_edf_task0, BENCH_STACK_DEPTH, "b_edf0", 2, sched_period[0], 0);
+    task_create_edf((void *)sched_edf_task1, BENCH_STACK_DEPTH, "b_edf1", 4, sched_period[1], 0);
+    bench_spawn((void *)sched_rm_task0, "b_rm0", SCHED_PRIO_RM0);
+    bench_spawn((void *)sched_rm_task1, "b_rm1", SCHED_PRIO_RM1);
+
+    bench_spawn((void *)sched_bench_task, "b_sched", BENCH_PRIORITY);
+}
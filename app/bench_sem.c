@@ -0,0 +1,45 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ޾ sem_take/sem_give һҪ
+// û˵ȡп棬 OS_SEM_FAST_PATH_ENABLE ֻ LDREX/STREXٽ
+// ˳һ task_enter_critical/task_exit_critical· takegive Ҫһ
+//  os_config.h  OS_SEM_FAST_PATH_ENABLE ĳ 0 ±Ƕ
+// ============================================================
+#define SEM_BENCH_LOOPS     10000
+
+static sem_t *sem_bench_sem;
+
+static void sem_pair(void)
+{
+    sem_take(sem_bench_sem);
+    sem_give(sem_bench_sem);
+}
+
+static void critical_pair(void)
+{
+    task_enter_critical();
+    task_exit_critical();
+}
+
+static void sem_bench_task(void)
+{
+    bench_begin("uncontended semaphore");
+    printf("[bench] OS_SEM_FAST_PATH_ENABLE = %u\r\n", (unsigned)OS_SEM_FAST_PATH_ENABLE);
+
+    bench_measure("sem take+give, uncontended", sem_pair, SEM_BENCH_LOOPS);
+    bench_measure("critical enter+exit", critical_pair, SEM_BENCH_LOOPS);
+
+    bench_finish();
+}
+
+void bench_sem_start(void)
+{
+    sem_bench_sem = sem_create(1);
+
+    bench_spawn((void *)sem_bench_task, "b_sem", BENCH_PRIORITY);
+}
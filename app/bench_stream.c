@@ -0,0 +1,113 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ֽ vs һһֽڵ
+// ÿд STREAM_BURST ֽ (񴮿 DMA С)һ STREAM_BYTES 
+// ȼ߸ߣȡһ˼
+//   䣺һֽ post һΣÿֽڶҪ
+//   ܹ STREAM_TRIGGER ֽڲŽѣһΰĶ
+//  bytes/s ÿ KB ߵĴ
+// ============================================================
+#define STREAM_BYTES        32768
+#define STREAM_BURST        16
+#define STREAM_SIZE         1024
+#define STREAM_TRIGGER      128
+
+#define STREAM_PRIO_CONS    (BENCH_PRIORITY - 1)
+#define STREAM_PRIO_PROD    (BENCH_PRIORITY - 2)
+
+static mailbox_t *stream_mbox;
+static stream_buf_t *stream_sb;
+static sem_t *stream_done;
+static volatile uint32_t stream_wakeups;
+
+static void stream_mbox_consumer(void)
+{
+    uint32_t got;
+
+    while (1)
+    {
+        for (got = 0; got < STREAM_BYTES; got++)
+        {
+            (void)mbox_fetch(stream_mbox);
+            stream_wakeups++;
+        }
+        sem_give(stream_done);
+    }
+}
+
+static void stream_sb_consumer(void)
+{
+    static uint8_t buf[STREAM_SIZE];
+    uint32_t got;
+
+    while (1)
+    {
+        for (got = 0; got < STREAM_BYTES; )
+        {
+            got += stream_buf_recv(stream_sb, buf, sizeof(buf), OS_WAIT_FOREVER);
+            stream_wakeups++;
+        }
+        sem_give(stream_done);
+    }
+}
+
+static void stream_report(const char *name, uint32_t cycles)
+{
+    bench_report(name, cycles, STREAM_BYTES);
+    bench_report_rate(STREAM_BYTES, cycles, "bytes");
+    bench_report_ratio(stream_wakeups, STREAM_BYTES / 1024u, "wakeups per KB");
+}
+
+static void stream_bench_task(void)
+{
+    uint8_t burst[STREAM_BURST];
+    uint32_t i, j, t0;
+
+    bench_begin("byte stream, stream buffer vs mailbox");
+
+    for (i = 0; i < STREAM_BURST; i++)
+    {
+        burst[i] = (uint8_t)i;
+    }
+
+    // 1. 䣬һֽһ
+    stream_wakeups = 0;
+    t0 = BENCH_CYCLES();
+    for (i = 0; i < STREAM_BYTES; i += STREAM_BURST)
+    {
+        for (j = 0; j < STREAM_BURST; j++)
+        {
+            mbox_post(stream_mbox, (void *)(uint32_t)burst[j]);
+        }
+    }
+    sem_take(stream_done);
+    stream_report("mbox, byte at a time", BENCH_CYCLES() - t0);
+
+    // 2. һһдܹˮλŽ
+    stream_wakeups = 0;
+    t0 = BENCH_CYCLES();
+    for (i = 0; i < STREAM_BYTES; i += STREAM_BURST)
+    {
+        stream_buf_send(stream_sb, burst, STREAM_BURST, OS_WAIT_FOREVER);
+    }
+    sem_take(stream_done);
+    stream_report("stream buffer, trigger 128", BENCH_CYCLES() - t0);
+
+    bench_finish();
+}
+
+void bench_stream_start(void)
+{
+    stream_mbox = mbox_create();
+    stream_sb = stream_buf_create(STREAM_SIZE, STREAM_TRIGGER);
+    stream_done = sem_create(0);
+
+    bench_spawn((void *)stream_bench_task, "b_strm", STREAM_PRIO_PROD);
+    bench_spawn((void *)stream_mbox_consumer, "b_strm_m", STREAM_PRIO_CONS);
+    bench_spawn((void *)stream_sb_consumer, "b_strm_s", STREAM_PRIO_CONS);
+}
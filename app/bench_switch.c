@@ -0,0 +1,79 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "stm32f4xx.h"
+#include "task.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// PendSV лӳ
+// 1. лȼ L ٽȼ H ŵź (PendSV ȹ)ʱ䣬˳ٽ
+//    PendSV е HH  sem_take غٶһΡֵǱֳ + ѡ + ֳָ
+//    ( task_exit_critical  sem_take صǼָ)
+// 2. лֻԼܵʱһ PendSV·˷ѡĻԼֱֳӷ
+// ǰ PendSV_Handler ȣ git ȡɵ os_cpu.s ±һ
+// ============================================================
+#define SWITCH_LOOPS        1000
+
+#define SWITCH_PRIO_H       (BENCH_PRIORITY - 1)
+#define SWITCH_PRIO_L       (BENCH_PRIORITY - 2)
+
+static sem_t *switch_sem;
+static sem_t *switch_done;
+static volatile uint32_t switch_t0;
+static bench_stat_t switch_stat;
+
+static void switch_task_h(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < SWITCH_LOOPS; i++)
+    {
+        sem_take(switch_sem);
+        bench_stat_add(&switch_stat, BENCH_CYCLES() - switch_t0);
+    }
+    sem_give(switch_done);
+    bench_park();
+}
+
+static void switch_task_l(void)
+{
+    while (1)
+    {
+        task_enter_critical();
+        sem_give(switch_sem);           // H ˣPendSV  BASEPRI 
+        switch_t0 = BENCH_CYCLES();
+        task_exit_critical();           // 
+    }
+}
+
+static void switch_pend_self(void)
+{
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    __DSB();
+    __ISB();
+}
+
+static void switch_bench_task(void)
+{
+    bench_begin("pendsv switch latency");
+
+    // 1. лԼȼߣ PendSV ԺѡĻԼ
+    bench_measure("pendsv, same task", switch_pend_self, SWITCH_LOOPS);
+
+    // 2. лó CPULH ȥܣ H 
+    sem_take(switch_done);
+    bench_report_stat("pendsv, task to task", &switch_stat);
+
+    bench_finish();
+}
+
+void bench_switch_start(void)
+{
+    switch_sem = sem_create(0);
+    switch_done = sem_create(0);
+
+    bench_spawn((void *)switch_bench_task, "b_sw", BENCH_PRIORITY);
+    bench_spawn((void *)switch_task_h, "b_sw_h", SWITCH_PRIO_H);
+    bench_spawn((void *)switch_task_l, "b_sw_l", SWITCH_PRIO_L);
+}
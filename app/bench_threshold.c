@@ -0,0 +1,90 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "scheduler.h"
+#include "event.h"
+#include "bench.h"
+
+// ============================================================
+// ռֵ/ˮߵл
+//  P ÿһݾ sem_give һΣȼߵ C ÿ sem_take һȡһ
+// ֵÿһ C ռһ
+// P ֵᵽ C ȼC  PP һꡢȽʱóC һȡ
+// ============================================================
+#define PIPE_ITEMS          10000
+
+#define PIPE_PRIO_C         (BENCH_PRIORITY - 1)
+#define PIPE_PRIO_P         (BENCH_PRIORITY - 2)
+
+static sem_t *pipe_items;   // P -> C
+static sem_t *pipe_go;      //  -> Pʼһ
+static sem_t *pipe_done;    // C -> һȡ
+static task_tcb *pipe_p_tcb;
+
+static void pipe_producer(void)
+{
+    uint32_t i;
+
+    while (1)
+    {
+        sem_take(pipe_go);
+        for (i = 0; i < PIPE_ITEMS; i++)
+        {
+            sem_give(pipe_items);
+        }
+    }
+}
+
+static void pipe_consumer(void)
+{
+    uint32_t i;
+
+    while (1)
+    {
+        for (i = 0; i < PIPE_ITEMS; i++)
+        {
+            sem_take(pipe_items);
+        }
+        sem_give(pipe_done);
+    }
+}
+
+// һƽÿݵл
+static void pipe_run(const char *name, uint32_t threshold)
+{
+    uint32_t t0, switches, cycles;
+
+    task_set_preempt_threshold(pipe_p_tcb, threshold);
+
+    switches = os_switch_count;
+    t0 = BENCH_CYCLES();
+    sem_give(pipe_go);
+    sem_take(pipe_done);
+    cycles = BENCH_CYCLES() - t0;
+    switches = os_switch_count - switches;
+
+    bench_report(name, cycles, PIPE_ITEMS);
+    bench_report_rate(PIPE_ITEMS, cycles, "items");
+    bench_report_ratio(switches, PIPE_ITEMS, "switches per item");
+}
+
+static void pipe_bench_task(void)
+{
+    bench_begin("preemption threshold, producer/consumer pipeline");
+
+    pipe_run("pipeline, no threshold", PIPE_PRIO_P);
+    pipe_run("pipeline, threshold = C", PIPE_PRIO_C);
+
+    bench_finish();
+}
+
+void bench_threshold_start(void)
+{
+    pipe_items = sem_create(0);
+    pipe_go = sem_create(0);
+    pipe_done = sem_create(0);
+
+    bench_spawn((void *)pipe_bench_task, "b_pipe", BENCH_PRIORITY);
+    bench_spawn((void *)pipe_consumer, "b_pipe_c", PIPE_PRIO_C);
+    pipe_p_tcb = bench_spawn((void *)pipe_producer, "b_pipe_p", PIPE_PRIO_P);
+}
@@ -0,0 +1,95 @@
+#include <stdint.h>
+#include <stdio.h>
+#include "task.h"
+#include "os_delay.h"
+#include "bench.h"
+
+// ============================================================
+// Tick жϺʱ vs ˯
+// ȼߣһֱڶ CYCCNTζ֮ĴȱھǱ SysTick ϵʱ
+// (ӲжϺһѭļ)ʱӦú˯Ķ޹
+//
+// ˯þ̬ TCB 棬ֱӹҵʱϣջԶᱻ
+// (256 ջ RAM Ų)ʱ䶼ںԶĽժ
+// ============================================================
+#define TICK_BENCH_MAX_SLEEPERS 256
+#define TICK_BENCH_TICKS        2000        // ÿһٸ Tick
+#define TICK_BENCH_GAP_MIN      60          // ȱڳôڲ㱻жϴ
+#define TICK_BENCH_SLEEP_BASE   1000000u    // Ļʱ (Tick1000 Ժ)
+
+static task_tcb sleeper[TICK_BENCH_MAX_SLEEPERS];
+
+static const uint32_t sleeper_counts[] = {1, 16, 64, 256};
+
+//  n ʱÿﶼһЩȼҲ
+static void sleepers_arm(uint32_t n)
+{
+    uint32_t i;
+
+    task_enter_critical();
+    for (i = 0; i < n; i++)
+    {
+        sleeper[i].delay_node.owner_tcb = &sleeper[i];
+        sleeper[i].task_priority = 1 + (i % (MAX_PRIORITY - 2));
+        sleeper[i].wait_queue = NULL;
+        os_delay_arm(&sleeper[i], TICK_BENCH_SLEEP_BASE + i * 7);
+    }
+    task_exit_critical();
+}
+
+static void sleepers_cancel(uint32_t n)
+{
+    uint32_t i;
+
+    task_enter_critical();
+    for (i = 0; i < n; i++)
+    {
+        os_delay_cancel(&sleeper[i]);
+    }
+    task_exit_critical();
+}
+
+static void tick_bench_task(void)
+{
+    uint32_t k;
+
+    bench_begin("tick isr cost vs sleeping tasks");
+
+    for (k = 0; k < sizeof(sleeper_counts) / sizeof(sleeper_counts[0]); k++)
+    {
+        uint32_t n = sleeper_counts[k];
+        uint32_t start_tick, last, now;
+        bench_stat_t st = {0, 0, 0};
+        char name[32];
+
+        sleepers_arm(n);
+
+        // 뵽 Tick ߽ٿʼ
+        start_tick = os_get_tick();
+        while (os_get_tick() == start_tick);
+        start_tick = os_get_tick();
+
+        last = BENCH_CYCLES();
+        while (os_get_tick() - start_tick < TICK_BENCH_TICKS)
+        {
+            now = BENCH_CYCLES();
+            if (now - last > TICK_BENCH_GAP_MIN)
+            {
+                bench_stat_add(&st, now - last);
+            }
+            last = now;
+        }
+
+        sleepers_cancel(n);
+
+        sprintf(name, "tick isr, %u sleeping", (unsigned)n);
+        bench_report_stat(name, &st);
+    }
+
+    bench_finish();
+}
+
+void bench_tick_isr_start(void)
+{
+    bench_spawn((void *)tick_bench_task, "b_tick", BENCH_PRIORITY);
+}
@@ -9,9 +9,18 @@
 #include "scheduler.h"
 #include "event.h"
 #include "sem.h"
+#include "bench.h"
 
 int main()
 {
+    usart_init();
+    os_init();
+
+    // ܲ (bench.h  BENCH_SELECT ѡĬϲ)
+    bench_start();
+
+    start_scheduler();
+
     while (1)
     {
         ;
@@ -5,13 +5,15 @@
 #include "scheduler.h"
 #include "task.h"
 #include "list.h"
+#include "os_delay.h"
 
 #define TICKS_PER_MS    (SystemCoreClock / 1000)
 #define TICKS_PER_US    (SystemCoreClock / 1000000)
-extern volatile uint8_t OSSchedLockNesting;
 
 static volatile uint64_t cpu_tick_count;
 static cpu_periodic_callback_t periodic_callback;
+// Tickless ڼ䱻ʡ SysTick жϴ (ʡЧ)
+static volatile uint64_t suppressed_ticks;
 
 void cpu_tick_init(void)
 {
@@ -30,6 +32,19 @@ uint64_t cpu_now(void)
     return now;
 }
 
+// ǰ Tick Ѿ˶ٸ CPU  (㶶/Ӧʱ)
+// ڹжϵʱã SysTick Ѿжϻûں˻û TickҪ
+uint32_t cpu_tick_elapsed(void)
+{
+    uint32_t elapsed = SysTick->LOAD - SysTick->VAL;
+
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        elapsed = SysTick->LOAD - SysTick->VAL + TICKS_PER_MS; // ˣ¶һ
+    }
+    return elapsed;
+}
+
 uint64_t cpu_get_us(void)
 {
     return cpu_now() / TICKS_PER_US;
@@ -57,65 +72,88 @@ void cpu_register_periodic_callback(cpu_periodic_callback_t callback)
     periodic_callback = callback;
 }
 
-void SysTick_Handler(void)
+uint64_t cpu_get_suppressed_ticks(void)
 {
-    cpu_tick_count += TICKS_PER_MS;
-    if (periodic_callback)
-        periodic_callback();
-
-    // ============================================================
-    // !!! ʱָ
-    // ============================================================
-    list_node_t *node = DelayedList.head;
-    list_node_t *next_node;
-
-    while (node != NULL)
-    //*û
-    {
-        // һڵ㣨Ϊǰڵܱߣ
-        next_node = node->next;
+    uint64_t ticks;
+    do {
+        ticks = suppressed_ticks;
+    } while (ticks != suppressed_ticks);
+    return ticks;
+}
 
-        // ҵ TCB
-        task_tcb *tcb = (task_tcb *)(node->owner_tcb);
+// ============================================================
+// Tickless ˯ (ɿڹж״̬µ)
+//  SysTick ʱĳһԶʱֱ˯ expected_ticks  Tick ֮
+// ָģʽм䱻ʡ Tick  (ɵ߲ں)
+// ============================================================
+uint32_t cpu_tick_sleep(uint32_t expected_ticks)
+{
+    uint32_t reload, passed, complete_ticks;
+    uint32_t max_ticks = SysTick_LOAD_RELOAD_Msk / TICKS_PER_MS;
 
-        // ʱ
-        if (tcb->delay_ticks > 0)
-        {
-            tcb->delay_ticks--;
-        }
+    // עڻصĻҪÿ Tick ãʡ
+    if (periodic_callback != NULL || expected_ticks < 2) return 0;
 
-        // ---Ѳ---
-        if (tcb->delay_ticks == 0)
-        {
-            // A. ﻮ
-            list_remove(&DelayedList, node);
+    // SysTick ֻ 24 λ˯̫ã˯һ־
+    if (expected_ticks > max_ticks) expected_ticks = max_ticks;
 
-            // B. ¼ӻؾ
-            list_insert_end(&ReadyList[tcb->task_priority], node);
+    // 1. ͣһԶʱװֵ (ǰ Tick ʣµ + )
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    reload = SysTick->VAL + TICKS_PER_MS * (expected_ticks - 1);
 
-            // C. λͼ
-            bitmap_set(tcb->task_priority);
-        }
-        // --------------------------
+    // !ͣǰպ Tick жѾˣ˯
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        return 0;
+    }
 
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
 
-        //!жǷΪգ
-        if (DelayedList.head == NULL) break;
-        // һ˯
-        node = next_node;
+    // 2. ˯ (ж״̬ WFI Ȼᱻжϻѣֻʱ ISR)
+    __DSB();
+    __WFI();
+    __ISB();
 
-        // ֹѭ (˫ѭ)
-        if (node == DelayedList.head) break;
-    }
+    // 3. ͣ (ֻд CTRL ־)
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk;
 
-    if (OSSchedLockNesting == 0)
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
     {
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+        // 3A. һֱ˯죺 SysTick жϻᲹһ Tick
+        // ִ reload ʼһСΣҪһ Tick ۵
+        passed = reload - SysTick->VAL;
+        complete_ticks = expected_ticks - 1;
+        SysTick->LOAD = (passed < TICKS_PER_MS) ? (TICKS_PER_MS - passed) : TICKS_PER_MS;
     }
     else
     {
-        // סˣȻʱƬˣҲֻţл
-        // ϵͳеǰ
-        // Լ OSSchedUnlock() 0ʱﲹл
+        // 3B. жǰѣ˯˼ Tickʣµͷ
+        passed = expected_ticks * TICKS_PER_MS - SysTick->VAL;
+        complete_ticks = passed / TICKS_PER_MS;
+        SysTick->LOAD = (complete_ticks + 1) * TICKS_PER_MS - passed;
     }
+
+    // 4. ͷȻװֵĻ 1ms (´Զָģʽ)
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = TICKS_PER_MS;
+
+    // 5. һԲ˯ʱ
+    cpu_tick_count += (uint64_t)complete_ticks * TICKS_PER_MS;
+    suppressed_ticks += complete_ticks;
+
+    return complete_ticks;
+}
+
+void SysTick_Handler(void)
+{
+    cpu_tick_count += TICKS_PER_MS;
+    if (periodic_callback)
+        periodic_callback();
+
+    // ʱѡȶں
+    os_tick_handler();
 }
@@ -7,10 +7,13 @@ typedef void (*cpu_periodic_callback_t)(void);
 
 void cpu_tick_init(void);
 uint64_t cpu_now(void);
+uint32_t cpu_tick_elapsed(void);
 uint64_t cpu_get_us(void);
 uint64_t cpu_get_ms(void);
 void cpu_delay_us(uint32_t us);
 void cpu_delay_ms(uint32_t ms);
 void cpu_register_periodic_callback(cpu_periodic_callback_t callback);
+uint32_t cpu_tick_sleep(uint32_t expected_ticks);
+uint64_t cpu_get_suppressed_ticks(void);
 
 #endif /* __CPU_DELAY_H__ */
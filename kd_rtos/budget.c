@@ -0,0 +1,226 @@
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "event.h"
+#include "os_delay.h"
+
+#if OS_BUDGET_ENABLE
+
+// ============================================================
+// CPU Ԥ (򻯵 Sporadic Server)
+// һִʱԤ (CPU ) Ͳ (Tick)
+// Ԥ״̬ʼܣͿʼʱһٰԤװ
+// ڼùԤ㣬Ҫǫ̂ȼ (пв)ҪôֱӹȲ䡣
+//  os_stats_account  DWT ڼˣSysTick  PendSV 
+// ============================================================
+
+// Ԥ״̬
+#define BUDGET_STATE_FULL       0   // Ԥʱûʼ
+#define BUDGET_STATE_ACTIVE     1   // Ԥ㣬Ȳ
+#define BUDGET_STATE_EXHAUSTED  2   // ùˣѾ/𣬵Ȳ
+
+// Ԥ񴮳һ (ÿ Tick 鲹ʱ)
+static task_tcb *budget_list_head = NULL;
+
+// Ԥùⱻ
+static list_t BudgetSuspendList = { NULL, 0 };
+
+// ˣ cycles 㵽Ԥ ( os_stats_account )
+void os_budget_charge(task_tcb *tcb, uint32_t cycles)
+{
+    if (tcb->budget_cycles == 0 || cycles == 0) return;
+    if (tcb->budget_state == BUDGET_STATE_EXHAUSTED) return;
+
+    // Ԥʼɻʱڿʼ
+    if (tcb->budget_state == BUDGET_STATE_FULL)
+    {
+        tcb->budget_state = BUDGET_STATE_ACTIVE;
+        tcb->budget_replenish_tick = os_get_tick() + tcb->budget_period;
+    }
+    tcb->budget_used += cycles;
+}
+
+// Ԥù⣺һγ֧Ȼ󽵼
+static void budget_exhaust(task_tcb *tcb)
+{
+    uint32_t overrun = tcb->budget_used - tcb->budget_cycles;
+
+    tcb->budget_state = BUDGET_STATE_EXHAUSTED;
+    tcb->budget_overruns++;
+    if (overrun > tcb->budget_overrun_max)
+    {
+        tcb->budget_overrun_max = overrun;
+    }
+
+    if (tcb->budget_action == BUDGET_ACTION_DEMOTE)
+    {
+        // ̨ȼ (Ļȼ̳Ч)
+        tcb->budget_saved_prio = tcb->base_priority;
+        tcb->budget_saved_threshold = tcb->preempt_threshold;
+        tcb->base_priority = OS_BUDGET_BG_PRIORITY;
+        tcb->preempt_threshold = OS_BUDGET_BG_PRIORITY;
+        mutex_priority_update(tcb);
+    }
+}
+
+// 𣺴Ӿбᵽ BudgetSuspendList
+// պ (ھб) Ȳܣһμٹ
+static uint32_t budget_suspend(task_tcb *tcb)
+{
+    if (tcb->status_node.container != &ReadyList[tcb->task_priority]) return 0;
+
+    task_ready_remove(tcb);
+    list_insert_end(&BudgetSuspendList, &tcb->status_node);
+    return 1;
+}
+
+// Ԥ㣺װָȼķŻؾб
+//  1 ʾҪµ
+static uint32_t budget_replenish(task_tcb *tcb)
+{
+    uint32_t need_switch = 0;
+
+    if (tcb->budget_state == BUDGET_STATE_EXHAUSTED)
+    {
+        if (tcb->budget_action == BUDGET_ACTION_DEMOTE)
+        {
+            tcb->base_priority = tcb->budget_saved_prio;
+            tcb->preempt_threshold = tcb->budget_saved_threshold;
+            mutex_priority_update(tcb);
+            need_switch = (tcb != current_tcb &&
+                           tcb->status_node.container == &ReadyList[tcb->task_priority] &&
+                           task_can_preempt(tcb));
+        }
+        else if (tcb->status_node.container == &BudgetSuspendList)
+        {
+            list_remove(&BudgetSuspendList, &tcb->status_node);
+            task_ready_insert(tcb);
+            need_switch = task_can_preempt(tcb);
+        }
+    }
+
+    tcb->budget_used = 0;
+    tcb->budget_state = BUDGET_STATE_FULL;
+    return need_switch;
+}
+
+// ============================================================
+// 鵱ǰԤ (SysTick  PendSV ã߸ж)
+//  1 ʾǰ񱻽/ˣҪµ
+// ============================================================
+uint32_t os_budget_enforce(void)
+{
+    task_tcb *tcb = current_tcb;
+
+    if (tcb == NULL || tcb->budget_cycles == 0) return 0;
+
+    if (tcb->budget_state != BUDGET_STATE_EXHAUSTED)
+    {
+        if (tcb->budget_used < tcb->budget_cycles) return 0;
+
+        budget_exhaust(tcb);
+        if (tcb->budget_action == BUDGET_ACTION_DEMOTE) return 1;
+    }
+
+    // ģʽù˻ھб (ϴμʱ)ڹ
+    if (tcb->budget_action == BUDGET_ACTION_SUSPEND)
+    {
+        return budget_suspend(tcb);
+    }
+    return 0;
+}
+
+// ============================================================
+// Ԥ Tick  ( os_tick_handler )
+// Ĳһ£ټ鵱ǰûг֧
+// ============================================================
+uint32_t os_budget_tick(void)
+{
+    uint32_t need_switch = 0;
+    uint32_t now = os_get_tick();
+    task_tcb *tcb;
+
+    for (tcb = budget_list_head; tcb != NULL; tcb = tcb->budget_next)
+    {
+        if (tcb->budget_state != BUDGET_STATE_FULL &&
+            (int32_t)(now - tcb->budget_replenish_tick) >= 0)
+        {
+            need_switch |= budget_replenish(tcb);
+        }
+    }
+
+    need_switch |= os_budget_enforce();
+    return need_switch;
+}
+
+// ============================================================
+// ѯһԤ㲹仹жٸ Tick ( Tickless ãҪж)
+// ֻѾùģ밴ʱų
+// ============================================================
+uint32_t os_budget_next_expiry(void)
+{
+    uint32_t min_ticks = OS_DELAY_NO_EXPIRY;
+    uint32_t now = os_get_tick();
+    task_tcb *tcb;
+
+    for (tcb = budget_list_head; tcb != NULL; tcb = tcb->budget_next)
+    {
+        if (tcb->budget_state == BUDGET_STATE_EXHAUSTED)
+        {
+            int32_t remain = (int32_t)(tcb->budget_replenish_tick - now);
+            if (remain <= 0) return 0;
+            if ((uint32_t)remain < min_ticks) min_ticks = (uint32_t)remain;
+        }
+    }
+    return min_ticks;
+}
+
+// ============================================================
+//  CPU Ԥ
+// budget_us:    ÿܶ΢ (0 = ȡԤ)
+// period_ticks:  (Tick)
+// action:       ùԺô죺BUDGET_ACTION_DEMOTE (̨) / BUDGET_ACTION_SUSPEND ()
+//               û DEMOTEҪȲԺŷŵó
+//  0 ɹ-1 
+// ============================================================
+int task_set_budget(task_tcb *tcb, uint32_t budget_us, uint32_t period_ticks, uint32_t action)
+{
+    task_tcb **pp;
+
+    if (tcb == NULL || tcb == idle_tcb) return -1;
+    if (budget_us != 0 && period_ticks == 0) return -1;
+    if (action != BUDGET_ACTION_DEMOTE && action != BUDGET_ACTION_SUSPEND) return -1;
+
+    task_enter_critical();
+
+    // ȰѾɵ״̬ʰɾ (Ļָķų)
+    if (budget_replenish(tcb) && OSSchedLockNesting == 0)
+    {
+        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    }
+
+    // ԤժҪĻٹһȥ
+    for (pp = &budget_list_head; *pp != NULL; pp = &(*pp)->budget_next)
+    {
+        if (*pp == tcb)
+        {
+            *pp = tcb->budget_next;
+            break;
+        }
+    }
+    tcb->budget_next = NULL;
+
+    tcb->budget_cycles = (uint32_t)(((uint64_t)budget_us * SystemCoreClock) / 1000000u);
+    tcb->budget_period = period_ticks;
+    tcb->budget_action = (uint8_t)action;
+
+    if (tcb->budget_cycles != 0)
+    {
+        tcb->budget_next = budget_list_head;
+        budget_list_head = tcb;
+    }
+
+    task_exit_critical();
+    return 0;
+}
+
+#endif
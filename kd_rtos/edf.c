@@ -0,0 +1,162 @@
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "os_delay.h"
+
+#if OS_EDF_ENABLE
+
+// ============================================================
+// EDF (ֹʱ) 
+//  EDF  OS_EDF_PRIORITY һȼϣ
+// һľбԽֹʱ򣬶ͷǸ
+// һߵͨռ EDF 񣬱͵ֻܵ EDF ˯˲
+// ============================================================
+
+// ѽɵ EDF  (λ֮һ)
+static uint32_t edf_total_util = 0;
+
+// 񰴽ֹʱ EDF ȼľб (߸ж)
+// ֹʱͬں ()
+// ̳ͨеһͨŵȴߵĽֹʱ (mutex.c)һ
+void edf_ready_insert(task_tcb *tcb)
+{
+    list_t *list = &ReadyList[OS_EDF_PRIORITY];
+    list_node_t *node = list->head;
+    list_node_t *pos = NULL;
+    uint32_t i;
+
+    for (i = 0; i < list->count; i++)
+    {
+        task_tcb *other = (task_tcb *)(node->owner_tcb);
+        if (DEADLINE_BEFORE(tcb->edf_deadline, other->edf_deadline))
+        {
+            pos = node;
+            break;
+        }
+        node = node->next;
+    }
+
+    list_insert_before(list, pos, &tcb->status_node);
+    bitmap_set(OS_EDF_PRIORITY);
+}
+
+//  EDF ֹʱ (ֹʱ̳)Ѿ EDF ƵξĻŶ (߸ж)
+void edf_set_deadline(task_tcb *tcb, uint32_t deadline)
+{
+    tcb->edf_deadline = deadline;
+
+    if (tcb->status_node.container == &ReadyList[OS_EDF_PRIORITY])
+    {
+        task_ready_remove(tcb);
+        edf_ready_insert(tcb);
+    }
+}
+
+// ============================================================
+//  EDF 
+// wcet:     ִʱ (Tick)
+// period:    (Tick)
+// deadline: Խֹʱ (Tick) 0 ʾ
+// ɲԣ EDF  wcet/deadline ֮Ͳܳ OS_EDF_UTIL_LIMIT
+// ͨͲ NULL
+// ============================================================
+task_tcb* task_create_edf(void *task_function, uint32_t task_stack_depth, char *task_name,
+                          uint32_t wcet, uint32_t period, uint32_t deadline)
+{
+    task_tcb *tcb;
+    uint32_t util;
+
+    if (period == 0 || wcet == 0) return NULL;
+    if (deadline == 0 || deadline > period) deadline = period;
+    if (wcet > deadline) return NULL;
+
+    // 1. ɲ (ֹʱڶ̵ʱ C/D C/T )
+    util = (uint32_t)(((uint64_t)wcet * 1000000u) / deadline);
+
+    task_enter_critical();
+    if (edf_total_util + util > (uint32_t)OS_EDF_UTIL_LIMIT * 1000u)
+    {
+        task_exit_critical();
+        return NULL;
+    }
+    edf_total_util += util;
+    task_exit_critical();
+
+    // 2. ͨ񴴽 EDF ȼ
+    tcb = task_create(task_function, task_stack_depth, task_name, OS_EDF_PRIORITY);
+    if (tcb == NULL)
+    {
+        task_enter_critical();
+        edf_total_util -= util;
+        task_exit_critical();
+        return NULL;
+    }
+
+    // 3. ڲֹʱŶ (һڴڿʼ)
+    task_enter_critical();
+    task_ready_remove(tcb);
+    tcb->task_options |= TASK_OPT_EDF;
+    tcb->period_ticks = period;
+    tcb->period_deadline = deadline;
+    tcb->edf_util = util;
+    tcb->period_release = os_get_tick();
+    tcb->edf_deadline = tcb->period_release + deadline;
+    task_ready_insert(tcb);
+    task_exit_critical();
+
+    return tcb;
+}
+
+// ============================================================
+// ڵĻˣ˯һڿʼ
+// ֹʱѾ˾ͼһγʱһѾʼ (ʱ̫) Ͳ˯
+// ֱӰµĽֹʱŶ
+// ============================================================
+void edf_wait_next_period(void)
+{
+    task_tcb *tcb = current_tcb;
+    uint32_t now;
+
+    if (tcb == NULL || !(tcb->task_options & TASK_OPT_EDF)) return;
+
+    // סʱ
+    if (OSSchedLockNesting > 0) return;
+
+    task_enter_critical();
+    now = os_get_tick();
+
+    // Ӧʱ䡢ֹʱͳƺͨ (task_get_period_stats ܲ)
+    period_job_done(tcb);
+
+    // 1. ƽһ
+    tcb->period_release += tcb->period_ticks;
+    tcb->edf_deadline = tcb->period_release + tcb->period_deadline;
+
+    if (DEADLINE_BEFORE(now, tcb->period_release))
+    {
+        // 2. û¸ڣ˯ʱ (ʱ task_ready_insert ᰴ½ֹʱŶ)
+        os_delay_to_tick(tcb->period_release);
+    }
+    else if (tcb->status_node.container == &ReadyList[OS_EDF_PRIORITY])
+    {
+        // 3. ѾˣֹʱˣŶӣõûи
+        task_ready_remove(tcb);
+        task_ready_insert(tcb);
+        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    }
+
+    task_exit_critical();
+
+    // ... ˯һ ...
+
+    task_enter_critical();
+    period_job_started(tcb);
+    task_exit_critical();
+}
+
+// ѯǰѽɵ EDF  (λǧ֮һ)
+uint32_t edf_get_utilization(void)
+{
+    return edf_total_util / 1000u;
+}
+
+#endif
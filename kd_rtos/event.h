@@ -3,23 +3,42 @@
 
 #include "list.h" // Ҫõ
 #include "task.h"
+#include "wait_queue.h"
+#include "os_timer.h"
 
 // 1.¼ö
 typedef enum
 {
     EVENT_TYPE_SEM,     // ź
     EVENT_TYPE_QUEUE,    // 
-    EVENT_TYPE_MBOX     // !!!  !!!
+    EVENT_TYPE_MBOX,    // !!!  !!!
+    EVENT_TYPE_MUTEX,   // 
+    EVENT_TYPE_FLAG_GROUP, // ¼
+    EVENT_TYPE_STREAM,  // ֽ
+    EVENT_TYPE_MSG_BUF, // Ϣ (䳤Ϣ)
+    EVENT_TYPE_SELECT   // select  (ͬʱȶ)
 } event_type_t;
 
+struct select_set;
+
+// !!! ҽ select õĹ (ܱ select Ķ󶼴һ) !!!
+typedef struct
+{
+    struct select_set *set;     // ĸ (NULL=)
+    list_node_t member_node;    // ڼϵĳԱб
+    list_node_t ready_node;     // ʱڼϵľб
+} select_link_t;
+
 // 2. źṹ ( ECB һ־̬)
 typedef struct
 {
     event_type_t type;      // ͣǶֵź
-    list_t wait_list;
+    wait_queue_t wait_queue;
 
     // ڶֵźֻ 0  1
-    uint32_t counter;
+    // (û˵ȵʱ sem_take/sem_give  LDREX/STREX ֱӸٽ)
+    volatile uint32_t counter;
+    select_link_t select;   // select Ϲ
 } sem_t;
 
 // 3. ź״̬Ϣṹ
@@ -33,24 +52,169 @@ typedef struct
 typedef struct
 {
     event_type_t type;      // 
-    list_t wait_list;       // ȴб (ȴʼ)
+    wait_queue_t wait_queue;// ȴ (ȴʼ)
     void *msg;              // Ϣָ (ֻܴ1)
     uint8_t is_full;        // ״̬0=, 1=
+    select_link_t select;   // select Ϲ
 } mailbox_t;
 
+// !!! ṹ (ȼ̳) !!!
+typedef struct mutex
+{
+    event_type_t type;          // 
+    wait_queue_t wait_queue;    // ȴ ()
+    task_tcb *owner;            //  (NULL=û˳)
+    uint32_t lock_count;        // ݹ
+    struct mutex *held_next;    // һ (ָȼʱҪ)
+} mutex_t;
+
+// !!! ¼ṹ !!!
+// 32 ־λԵһλ (OR) ȫ (AND)
+typedef struct
+{
+    event_type_t type;          // 
+    wait_queue_t wait_queue;    // ȴ (ȱ־λ)
+    volatile uint32_t flags;    // ־
+    volatile uint32_t isr_bits; // жõλûʱ
+    os_defer_t isr_defer;       // жλƳٵʱɨȴ
+} event_group_t;
+
+// !!! Ϣнṹ (EVENT_TYPE_QUEUE) !!!
+// λϢֵȥ (ͷľֲͿԸ)
+typedef struct
+{
+    event_type_t type;          // 
+    wait_queue_t recv_wait;     // Ϣ (п)
+    wait_queue_t send_wait;     // ȿλ ()
+    uint8_t *buf;               // 洢 (ͽṹһ룬ڽṹ)
+    uint32_t item_size;         // ÿϢֽ
+    uint32_t capacity;          // 漸
+    uint32_t count;             // ǰ˼
+    uint32_t head;              // һҪλ (±)
+    uint32_t tail;              // һҪдλ (±)
+    select_link_t select;       // select Ϲ
+} queue_t;
+
+// !!!  / Ϣ (Bip-Buffer ) !!!
+// ݷֳΣ A [a_start, a_end)  B [0, b_end)Զ A
+// A Ų˲Ŵӻͷһ BA  B ͱµ A
+// Զһڴ棬ֱӽ DMA ߽ٿһ
+typedef struct
+{
+    event_type_t type;          // EVENT_TYPE_STREAM / EVENT_TYPE_MSG_BUF
+    wait_queue_t recv_wait;     // ݵ
+    wait_queue_t send_wait;     // ȿռ
+    uint8_t *buf;               // 洢 (ͽṹһ룬ڽṹ)
+    uint32_t size;              //  (ֽ)
+    uint32_t a_start;           //  A 
+    uint32_t a_end;             //  A յ
+    uint32_t b_end;             //  B յ (b_active ʱЧ)
+    uint8_t b_active;           //  B 
+    uint8_t wr_to_b;            // ԤȥĿռ B 
+    uint32_t wr_off;            // ԤȥĿռ
+    uint32_t wr_len;            // Ԥȥĳ (0 = ûԤ)
+    uint32_t trigger_level;     // ܹôֽڲŻѽ (Ϣ̶Ϊ 1)
+    select_link_t select;       // select Ϲ
+} stream_buf_t;
+
+typedef stream_buf_t msg_buf_t;
+
+// !!! select  (һͬʱȶź///) !!!
+// ԱʱԼҵб (O(1))ѵȼϵ
+typedef struct select_set
+{
+    event_type_t type;          // 
+    wait_queue_t wait_queue;    // ȼϵ
+    list_t members;             // гԱ
+    list_t ready_list;          // ݵĳԱ (select_wait ȡʱȷһ)
+} select_set_t;
+
+// event_group_wait ѡ (Ի)
+#define EVENT_WAIT_ANY          0x00 // ȵλһλ (OR)
+#define EVENT_WAIT_ALL          0x01 // ȵλȫ (AND)
+#define EVENT_CLEAR_ON_EXIT     0x02 // ʱѵȵλ
+
 // 
 sem_t* sem_create(uint32_t init_count);
 void sem_delete(sem_t *sem);
 void sem_take(sem_t *sem); // ȡź
+int sem_take_timeout(sem_t *sem, uint32_t timeout);
 void sem_give(sem_t *sem); // ͷź
+void sem_give_from_isr(sem_t *sem); // жͷ ( os_isr_enter/os_isr_exit)
 void sem_get_info(sem_t *sem, sem_info_t *info);
 uint32_t task_wait_notify(void);
+int task_wait_notify_timeout(uint32_t *value, uint32_t timeout);
 void task_notify(task_tcb *target_tcb, uint32_t value);
+void task_notify_from_isr(task_tcb *target_tcb, uint32_t value);
+int task_notify_ex(task_tcb *target_tcb, uint32_t index, uint32_t value, uint32_t action);
+int task_notify_ex_from_isr(task_tcb *target_tcb, uint32_t index, uint32_t value, uint32_t action);
+int task_wait_notify_ex(uint32_t index, uint32_t clear_on_entry, uint32_t clear_on_exit,
+                        uint32_t *value, uint32_t timeout);
+int task_notify_take(uint32_t index, uint32_t clear, uint32_t *value, uint32_t timeout);
 // 亯
 mailbox_t* mbox_create(void);
 void mbox_delete(mailbox_t *mbox);
 int mbox_post(mailbox_t *mbox, void *msg); //  ()
+int mbox_post_from_isr(mailbox_t *mbox, void *msg);
 void* mbox_fetch(mailbox_t *mbox);
+int mbox_fetch_timeout(mailbox_t *mbox, void **msg, uint32_t timeout);
+// 
+mutex_t* mutex_create(void);
+void mutex_priority_update(task_tcb *tcb);
+void mutex_delete(mutex_t *mutex);
+int mutex_lock(mutex_t *mutex);
+int mutex_lock_timeout(mutex_t *mutex, uint32_t timeout);
+int mutex_unlock(mutex_t *mutex);
+// Ϣк
+queue_t* queue_create(uint32_t capacity, uint32_t item_size);
+void queue_delete(queue_t *queue);
+int queue_send(queue_t *queue, const void *item, uint32_t timeout);
+int queue_send_to_front(queue_t *queue, const void *item, uint32_t timeout);
+int queue_send_from_isr(queue_t *queue, const void *item);
+int queue_recv(queue_t *queue, void *item, uint32_t timeout);
+int queue_peek(queue_t *queue, void *item, uint32_t timeout);
+uint32_t queue_count(queue_t *queue);
+// 
+stream_buf_t* stream_buf_create(uint32_t size, uint32_t trigger_level);
+void stream_buf_delete(stream_buf_t *sb);
+void stream_buf_set_trigger(stream_buf_t *sb, uint32_t trigger_level);
+uint32_t stream_buf_send(stream_buf_t *sb, const void *data, uint32_t len, uint32_t timeout);
+uint32_t stream_buf_send_from_isr(stream_buf_t *sb, const void *data, uint32_t len);
+uint8_t* stream_buf_send_reserve(stream_buf_t *sb, uint32_t *len, uint32_t timeout);
+void stream_buf_send_commit(stream_buf_t *sb, uint32_t len);
+uint32_t stream_buf_recv(stream_buf_t *sb, void *buf, uint32_t len, uint32_t timeout);
+uint8_t* stream_buf_recv_peek(stream_buf_t *sb, uint32_t *len, uint32_t timeout);
+void stream_buf_recv_release(stream_buf_t *sb, uint32_t len);
+uint32_t stream_buf_count(stream_buf_t *sb);
+// Ϣ
+msg_buf_t* msg_buf_create(uint32_t size);
+void msg_buf_delete(msg_buf_t *mb);
+int msg_buf_send(msg_buf_t *mb, const void *data, uint32_t len, uint32_t timeout);
+int msg_buf_send_from_isr(msg_buf_t *mb, const void *data, uint32_t len);
+void* msg_buf_send_reserve(msg_buf_t *mb, uint32_t len, uint32_t timeout);
+void msg_buf_send_commit(msg_buf_t *mb, uint32_t len);
+int msg_buf_recv(msg_buf_t *mb, void *buf, uint32_t max_len, uint32_t *len, uint32_t timeout);
+void* msg_buf_recv_peek(msg_buf_t *mb, uint32_t *len, uint32_t timeout);
+void msg_buf_recv_release(msg_buf_t *mb);
+// select Ϻ
+select_set_t* select_set_create(void);
+void select_set_delete(select_set_t *set);
+int select_add(select_set_t *set, void *obj);
+int select_remove(select_set_t *set, void *obj);
+void* select_wait(select_set_t *set, uint32_t timeout);
+// (ںڲã󴴽//ɾʱã߸ٽ)
+void select_link_init(select_link_t *link, void *obj);
+void select_signal(select_link_t *link);
+void select_detach(select_link_t *link);
+// ¼麯
+event_group_t* event_group_create(void);
+void event_group_delete(event_group_t *group);
+uint32_t event_group_set(event_group_t *group, uint32_t bits);
+uint32_t event_group_set_from_isr(event_group_t *group, uint32_t bits);
+uint32_t event_group_clear(event_group_t *group, uint32_t bits);
+uint32_t event_group_get(event_group_t *group);
+int event_group_wait(event_group_t *group, uint32_t bits, uint32_t opt,
+                     uint32_t *got_bits, uint32_t timeout);
 
 
 #endif
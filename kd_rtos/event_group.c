@@ -0,0 +1,275 @@
+#include "stm32f4xx.h"
+#include "event.h"
+#include "scheduler.h"
+#include "mem_pool.h"
+
+// ============================================================
+// ¼飺һ 32 λ־ + һȴ
+// ÿȴԼ (ЩλAND  OR)  TCB 
+// λʱѵȴɨһˣһȫ
+// ============================================================
+
+static uint32_t event_group_set_locked(event_group_t *group, uint32_t bits);
+#if OS_TIMER_ENABLE
+static void event_group_isr_deferred(void *arg);
+#endif
+
+// ־ flags ܲ " bitsѡ opt" 
+static __inline uint32_t event_group_match(uint32_t flags, uint32_t bits, uint32_t opt)
+{
+    if (opt & EVENT_WAIT_ALL)
+    {
+        return (flags & bits) == bits;
+    }
+    return (flags & bits) != 0;
+}
+
+// ============================================================
+// 1. ¼ (λʼΪ 0)
+// ============================================================
+event_group_t* event_group_create(void)
+{
+    event_group_t *group = (event_group_t *)os_mem_alloc(sizeof(event_group_t));
+    if (group == NULL) return NULL;
+
+    group->type = EVENT_TYPE_FLAG_GROUP;
+    wait_queue_init(&group->wait_queue);
+    group->flags = 0;
+    group->isr_bits = 0;
+#if OS_TIMER_ENABLE
+    os_defer_init(&group->isr_defer, event_group_isr_deferred, group);
+#endif
+
+    return group;
+}
+
+// ============================================================
+// 2. ɾ¼
+// ڵȵȫѣǵ event_group_wait  OS_ERR_DELETED
+// ============================================================
+void event_group_delete(event_group_t *group)
+{
+    task_tcb *waiter;
+
+    if (group == NULL) return;
+
+    task_enter_critical();
+
+#if OS_TIMER_ENABLE
+    // жõλûĻͲˣöʱѾͷŵڴ
+    os_defer_cancel(&group->isr_defer);
+#endif
+
+    // 峡Ժ¼Ѿûˣı־Ǵ
+    while ((waiter = wait_queue_peek(&group->wait_queue)) != NULL)
+    {
+        waiter->event_got_bits = group->flags;
+        wait_queue_take(&group->wait_queue, waiter, OS_ERR_DELETED);
+        task_ready_wake(waiter);
+    }
+    os_mem_free(group);
+
+    task_exit_critical();
+}
+
+// ============================================================
+// 3. λ
+// ĵȴһȫ (ǽһԼٲһ)
+// λ ( EVENT_CLEAR_ON_EXIT λ) ֮ı־
+// ============================================================
+uint32_t event_group_set(event_group_t *group, uint32_t bits)
+{
+    uint32_t flags;
+
+    if (group == NULL) return 0;
+
+    task_enter_critical();
+    flags = event_group_set_locked(group, bits);
+    task_exit_critical();
+
+    return flags;
+}
+
+// жϰ
+// ɨȴеʱ͵ȵȣܷж
+// жֻλǵ isr_bits ϣύʱ event_group_set ȥɨ
+// жʱǳ (ͬһ¼úüΣʱֻɨһ)
+// ֵλ֮ "" õı־ (ȴߴ˿ܻ̿û)
+// صʱ (OS_TIMER_ENABLE=0) Ļûжʱֻжֱɨ
+uint32_t event_group_set_from_isr(event_group_t *group, uint32_t bits)
+{
+    uint32_t mask, flags;
+
+    if (group == NULL) return 0;
+
+    mask = os_isr_mask();
+#if OS_TIMER_ENABLE
+    group->isr_bits |= bits;
+    flags = group->flags | group->isr_bits;
+    os_isr_unmask(mask);
+
+    os_defer_from_isr(&group->isr_defer);
+#else
+    flags = event_group_set_locked(group, bits);
+    os_isr_unmask(mask);
+#endif
+
+    return flags;
+}
+
+#if OS_TIMER_ENABLE
+// ڶʱжλһ
+static void event_group_isr_deferred(void *arg)
+{
+    event_group_t *group = (event_group_t *)arg;
+    uint32_t mask, bits;
+
+    mask = os_isr_mask();
+    bits = group->isr_bits;
+    group->isr_bits = 0;
+    os_isr_unmask(mask);
+
+    if (bits != 0)
+    {
+        (void)event_group_set(group, bits);
+    }
+}
+#endif
+
+// event_group_set  (߸ٽ)
+static uint32_t event_group_set_locked(event_group_t *group, uint32_t bits)
+{
+    wait_queue_t *wq = &group->wait_queue;
+    uint32_t pending, b, i, n;
+    uint32_t clear_bits = 0;
+    list_node_t *node, *next;
+    task_tcb *tcb;
+
+    group->flags |= bits;
+
+    // 1. ȼߵͰɨ (һλͼգɨĹͰᱻժ)
+    pending = wq->bitmap;
+    while (pending != 0)
+    {
+        b = 31 - __CLZ(pending);
+        pending &= ~(1u << b);
+
+        node = wq->bucket[b].head;
+        n = wq->bucket[b].count;
+        for (i = 0; i < n; i++)
+        {
+            // ժǰڵ֮ǰȼһ
+            next = node->next;
+            tcb = (task_tcb *)node->owner_tcb;
+
+            if (event_group_match(group->flags, tcb->event_wait_bits, tcb->event_wait_opt))
+            {
+                tcb->event_got_bits = group->flags;
+                if (tcb->event_wait_opt & EVENT_CLEAR_ON_EXIT)
+                {
+                    clear_bits |= tcb->event_wait_bits;
+                }
+
+                // ŻؾбռŴ
+                wait_queue_take(wq, tcb, OS_OK);
+                task_ready_wake(tcb);
+            }
+            node = next;
+        }
+    }
+
+    // 2. ɨλͬһλǰλӰж
+    group->flags &= ~clear_bits;
+
+    return group->flags;
+}
+
+// ============================================================
+// 4. λ (֮ǰı־)
+// ============================================================
+uint32_t event_group_clear(event_group_t *group, uint32_t bits)
+{
+    uint32_t flags;
+
+    if (group == NULL) return 0;
+
+    task_enter_critical();
+    flags = group->flags;
+    group->flags = flags & ~bits;
+    task_exit_critical();
+
+    return flags;
+}
+
+// ============================================================
+// 5. ־ (һֵĶԭӵģýٽ)
+// ============================================================
+uint32_t event_group_get(event_group_t *group)
+{
+    if (group == NULL) return 0;
+    return group->flags;
+}
+
+// ============================================================
+// 6. ȱ־λ
+// bits:     Щλ ( 0)
+// opt:      EVENT_WAIT_ANY / EVENT_WAIT_ALLٻ EVENT_CLEAR_ON_EXIT
+// got_bits: һ̵ı־ (ʱĻǳʱʱı־)ҪԴ NULL
+// timeout:  ȶٸ Tick (OS_NO_WAIT ȣOS_WAIT_FOREVER һֱ)
+//  OS_OK ȵˣOS_ERR_TIMEOUT ʱOS_ERR_DELETED ¼鱻ɾˣ
+// OS_ERR ߵס˲
+// ============================================================
+int event_group_wait(event_group_t *group, uint32_t bits, uint32_t opt,
+                     uint32_t *got_bits, uint32_t timeout)
+{
+    int result;
+
+    if (group == NULL || bits == 0) return OS_ERR;
+
+    task_enter_critical();
+
+    // --- AѾ㣬ֱӷ ---
+    if (event_group_match(group->flags, bits, opt))
+    {
+        if (got_bits != NULL) *got_bits = group->flags;
+        if (opt & EVENT_CLEAR_ON_EXIT) group->flags &= ~bits;
+        task_exit_critical();
+        return OS_OK;
+    }
+
+    // --- B㣬 ---
+    if (timeout == OS_NO_WAIT)
+    {
+        if (got_bits != NULL) *got_bits = group->flags;
+        task_exit_critical();
+        return OS_ERR_TIMEOUT;
+    }
+
+    // ˣϽ
+    if (OSSchedLockNesting > 0)
+    {
+        task_exit_critical();
+        return OS_ERR;
+    }
+
+    // --- C TCB ȥ˯ ---
+    current_tcb->event_wait_bits = bits;
+    current_tcb->event_wait_opt = (uint8_t)opt;
+    wait_queue_block(&group->wait_queue, timeout);
+    task_exit_critical();
+
+    // ... ߣevent_group_set ǽ (߳ʱ) ...
+    // (ҪλλһѾ)
+
+    task_enter_critical();
+    result = current_tcb->wait_result;
+    if (result == OS_ERR_TIMEOUT)
+    {
+        // ʱ¼黹ڣصǰı־
+        current_tcb->event_got_bits = group->flags;
+    }
+    if (got_bits != NULL) *got_bits = current_tcb->event_got_bits;
+    task_exit_critical();
+
+    return result;
+}
@@ -29,6 +29,30 @@ void list_insert_end(list_t *list, list_node_t *node)
         first->prev = node;
         last->next = node;
     }
+    node->container = list;
+    list->count++;
+}
+
+// ڵ뵽 pos ǰ ()pos Ϊ NULL ʱ嵽ĩβ
+void list_insert_before(list_t *list, list_node_t *pos, list_node_t *node)
+{
+    if (pos == NULL)
+    {
+        list_insert_end(list, node);
+        return;
+    }
+
+    node->next = pos;
+    node->prev = pos->prev;
+    pos->prev->next = node;
+    pos->prev = node;
+
+    // ͷڵǰ棬ͳµͷ
+    if (list->head == pos)
+    {
+        list->head = node;
+    }
+    node->container = list;
     list->count++;
 }
 
@@ -53,5 +77,6 @@ void list_remove(list_t *list, list_node_t *node)
             list->head = node->next;
         }
     }
+    node->container = NULL;
     list->count--;
 }
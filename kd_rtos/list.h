@@ -4,16 +4,21 @@
 #include <stdint.h>
 #include <stddef.h>
 
+struct list;
+
 // ڵṹ
+//! os_cpu.s  PendSV ·ֱӰƫƶ owner_tcb (ƫ 8)  list_t.headĲҪͬĻ
 typedef struct list_node
 {
     struct list_node *next; // ָһڵ
     struct list_node *prev; // ָһڵ
     void *owner_tcb;        // ָTCB (ͨڵҵ)
+    struct list *container; // ǰĸ (NULL=κ)
+    uint32_t value;         // õļֵ (ʱ浽ڵľ Tick)
 } list_node_t;
 
 // ͷṹ (һ)
-typedef struct
+typedef struct list
 {
     list_node_t *head;      // ͷڵ
     uint32_t count;         // ڵ
@@ -22,6 +27,7 @@ typedef struct
 // 
 void list_init(list_t *list);
 void list_insert_end(list_t *list, list_node_t *node);
+void list_insert_before(list_t *list, list_node_t *pos, list_node_t *node);
 void list_remove(list_t *list, list_node_t *node);
 
 #endif
@@ -1,20 +1,24 @@
-#include <stdlib.h>
 #include "stm32f4xx.h"
 #include "scheduler.h"
 #include "event.h"
+#include "os_delay.h"
+#include "mem_pool.h"
 
 extern list_t ReadyList[MAX_PRIORITY];
 
+static void mbox_post_locked(mailbox_t *mbox, void *msg);
+
 // 1. 
 mailbox_t* mbox_create(void)
 {
-    mailbox_t *mbox = (mailbox_t *)malloc(sizeof(mailbox_t));
+    mailbox_t *mbox = (mailbox_t *)os_mem_alloc(sizeof(mailbox_t));
     if (mbox == NULL) return NULL;
 
     mbox->type = EVENT_TYPE_MBOX;
-    list_init(&mbox->wait_list);
+    wait_queue_init(&mbox->wait_queue);
     mbox->msg = NULL;
     mbox->is_full = 0; // ʼΪ
+    select_link_init(&mbox->select, mbox);
 
     return mbox;
 }
@@ -26,17 +30,10 @@ void mbox_delete(mailbox_t *mbox)
 
     task_enter_critical();
     // 峡еȴ
-    while (mbox->wait_list.head != NULL)
-    {
-        list_node_t *node = mbox->wait_list.head;
-        task_tcb *tcb = (task_tcb *)(node->owner_tcb);
-        list_remove(&mbox->wait_list, node);
-        list_insert_end(&ReadyList[tcb->task_priority], node);
-        bitmap_set(tcb->task_priority);
-    }
-    free(mbox);
+    wait_queue_wake_all(&mbox->wait_queue, OS_ERR_DELETED);
+    select_detach(&mbox->select);
+    os_mem_free(mbox);
 
-    if (OSSchedLockNesting == 0) SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
     task_exit_critical();
 }
 
@@ -47,31 +44,36 @@ int mbox_post(mailbox_t *mbox, void *msg)
     if (mbox == NULL) return -1;
 
     task_enter_critical();
+    mbox_post_locked(mbox, msg);
+    task_exit_critical();
+    return 0;
+}
+
+// жϰ棺ѵҪж˳ (os_isr_exit) йȥ
+int mbox_post_from_isr(mailbox_t *mbox, void *msg)
+{
+    uint32_t mask;
+
+    if (mbox == NULL) return -1;
 
+    mask = os_isr_mask();
+    mbox_post_locked(mbox, msg);
+    os_isr_unmask(mask);
+    return 0;
+}
+
+// mbox_post  (߸ٽ)
+static void mbox_post_locked(mailbox_t *mbox, void *msg)
+{
     // A.  ()
     mbox->msg = msg;
     mbox->is_full = 1;
 
-    // B. ûڵ
-    if (mbox->wait_list.head != NULL)
-    {
-        // ѵһȴ
-        list_node_t *node = mbox->wait_list.head;
-        task_tcb *tcb = (task_tcb *)(node->owner_tcb);
-
-        list_remove(&mbox->wait_list, node);
-        list_insert_end(&ReadyList[tcb->task_priority], node);
-        bitmap_set(tcb->task_priority);
+    // B. ڵžͻȼߵǸʸռŴ
+    wait_queue_wake_one(&mbox->wait_queue);
 
-        // 
-        if (OSSchedLockNesting == 0)
-        {
-            SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-        }
-    }
-
-    task_exit_critical();
-    return 0;
+    // C.  select ĻȥǱߵǼһ
+    select_signal(&mbox->select);
 }
 
 // 4. ȡʼ (Fetch)
@@ -80,39 +82,67 @@ void* mbox_fetch(mailbox_t *mbox)
 {
     void *return_msg = NULL;
 
-    if (mbox == NULL) return NULL;
-    if (OSSchedLockNesting > 0) return NULL; // ס
+    (void)mbox_fetch_timeout(mbox, &return_msg, OS_WAIT_FOREVER);
+    return return_msg;
+}
+
+// 5. ʱȡ
+// timeout: ȶٸ Tick (OS_NO_WAIT ȣOS_WAIT_FOREVER һֱ)
+//  OS_OK յ ( *msg)OS_ERR_TIMEOUT ʱOS_ERR_DELETED 䱻ɾˣOS_ERR /ס
+int mbox_fetch_timeout(mailbox_t *mbox, void **msg, uint32_t timeout)
+{
+    uint32_t start;
+    int result;
+
+    if (mbox == NULL || msg == NULL) return OS_ERR;
 
     task_enter_critical();
+    start = os_get_tick();
 
     // --- A: ûţ˯ ---
-    // ʹ while Ϊ˷ֹٻѡ߱Ѻֱ(ȻFIFO)
+    // ʹ while Ϊ˷ֹٻѡ߱Ѻֱ
     while (mbox->is_full == 0)
     {
-        // 1. Ƴ
-        list_remove(&ReadyList[current_tcb->task_priority], &current_tcb->status_node);
-        if (ReadyList[current_tcb->task_priority].head == NULL)
+        uint32_t remain = timeout;
+
+        // Ѿȹһֱˣֻʣµʱ
+        if (timeout != OS_WAIT_FOREVER)
         {
-            bitmap_clear(current_tcb->task_priority);
+            uint32_t passed = os_get_tick() - start;
+            remain = (passed < timeout) ? (timeout - passed) : 0;
         }
 
-        // 2. ȴб
-        list_insert_end(&mbox->wait_list, &current_tcb->status_node);
+        if (remain == OS_NO_WAIT)
+        {
+            task_exit_critical();
+            return OS_ERR_TIMEOUT;
+        }
+        if (OSSchedLockNesting > 0) // ס
+        {
+            task_exit_critical();
+            return OS_ERR;
+        }
 
-        // 3. 
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+        // Ƴȴ (ʱĻͬʱʱ)
+        wait_queue_block(&mbox->wait_queue, remain);
         task_exit_critical();
 
         // ...  ...
-        // ... ȴ mbox_post  ...
+        // ... ȴ mbox_post ѣ߳ʱ ...
 
         task_enter_critical();
+        result = current_tcb->wait_result;
+        if (result != OS_OK)
+        {
+            task_exit_critical();
+            return result;
+        }
     }
 
-// --- B:  () ---
-return_msg = mbox->msg;
-mbox->is_full = 0; // ȡˣ
+    // --- B:  () ---
+    *msg = mbox->msg;
+    mbox->is_full = 0; // ȡˣ
 
-task_exit_critical();
-return return_msg;
+    task_exit_critical();
+    return OS_OK;
 }
@@ -0,0 +1,272 @@
+#include <stdlib.h>
+#include "stm32f4xx.h"
+#include "task.h"
+#include "event.h"
+#include "mem_pool.h"
+
+// ============================================================
+// ڴ
+// 룺ͷŻĿ飬ûоʹ fresh һ飬ǳ
+// ͷţһ free_list ͷ
+// ٽ os_isr_mask (BASEPRI) OS_MAX_SYSCALL_PRIORITY µж϶ܵ
+// ============================================================
+
+// пָдǺ ( 8 ֽڣŵ)ץظͷ
+#define MEM_POOL_FREE_MAGIC  0xF4EEB10Cu
+#define MEM_POOL_MAGIC_OF(block)  (*(uint32_t *)((void **)(block) + 1))
+
+// ǲѾڿ (߸ж)
+// ǺŶԲϵĿ϶ڣ˳ȷһ (ûɵڼǺŵ٣ƽʱ O(1))
+static uint32_t mem_pool_is_free(mem_pool_t *pool, void *block)
+{
+    void *p;
+
+    if ((uint8_t *)block >= pool->fresh) return 1; // ûгȥ
+    if (MEM_POOL_MAGIC_OF(block) != MEM_POOL_FREE_MAGIC) return 0;
+
+    for (p = pool->free_list; p != NULL; p = *(void **)p)
+    {
+        if (p == block) return 1;
+    }
+    return 0;
+}
+
+// ============================================================
+// 1. ʼ (mem ɵṩ 8 ֽڶ룬С >= MEM_POOL_WORDS * 8)
+//  OS_OK ɹOS_ERR 
+// ============================================================
+int mem_pool_init(mem_pool_t *pool, char *name, void *mem, uint32_t block_size, uint32_t block_count)
+{
+    if (pool == NULL || mem == NULL || block_size == 0 || block_count == 0) return OS_ERR;
+    if (((uintptr_t)mem & 7) != 0) return OS_ERR;
+
+    // Сճ 8 ıÿһ鶼 8 ֽڶ룬ֱӵջ߷ double
+    block_size = (block_size + 7u) & ~7u;
+
+    pool->free_list = NULL;
+    pool->fresh = (uint8_t *)mem;
+    pool->start = (uint8_t *)mem;
+    pool->end = (uint8_t *)mem + block_size * block_count;
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+    pool->used = 0;
+    pool->peak = 0;
+    pool->fail_count = 0;
+    pool->name = name;
+
+    return OS_OK;
+}
+
+// ============================================================
+// 2. һ (ؿ˷ NULLfail_count һ)
+// ============================================================
+void* mem_pool_alloc(mem_pool_t *pool)
+{
+    void *block;
+    uint32_t old = os_isr_mask();
+
+    if (pool->free_list != NULL)
+    {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+        MEM_POOL_MAGIC_OF(block) = 0; // мǺ
+    }
+    else if (pool->fresh < pool->end)
+    {
+        block = pool->fresh;
+        pool->fresh += pool->block_size;
+    }
+    else
+    {
+        pool->fail_count++;
+        os_isr_unmask(old);
+        return NULL;
+    }
+
+    pool->used++;
+    if (pool->used > pool->peak)
+    {
+        pool->peak = pool->used;
+    }
+
+    os_isr_unmask(old);
+    return block;
+}
+
+// ============================================================
+// 3. ͷһ
+//  OS_OK ɹOS_ERR гȥĿ (ָ벻ڷΧڻû뵽ͷ)
+// ظͷ (Ѿڿˣκζused ᱻɸ)
+// ============================================================
+int mem_pool_free(mem_pool_t *pool, void *block)
+{
+    uint32_t old;
+
+    if (!mem_pool_contains(pool, block)) return OS_ERR;
+    if (((uint8_t *)block - pool->start) % pool->block_size != 0) return OS_ERR;
+
+    old = os_isr_mask();
+
+    if (pool->used == 0 || mem_pool_is_free(pool, block))
+    {
+        os_isr_unmask(old);
+        return OS_ERR;
+    }
+
+    MEM_POOL_MAGIC_OF(block) = MEM_POOL_FREE_MAGIC;
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->used--;
+
+    os_isr_unmask(old);
+    return OS_OK;
+}
+
+// ָǲصڴ
+uint32_t mem_pool_contains(mem_pool_t *pool, void *p)
+{
+    return (uint8_t *)p >= pool->start && (uint8_t *)p < pool->end;
+}
+
+// ͳƿ
+void mem_pool_get_stats(mem_pool_t *pool, mem_pool_stats_t *stats)
+{
+    uint32_t old = os_isr_mask();
+
+    stats->name = pool->name;
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->used = pool->used;
+    stats->peak = pool->peak;
+    stats->fail_count = pool->fail_count;
+
+    os_isr_unmask(old);
+}
+
+// ============================================================
+// ں˶õķּڴ
+// TCBջֿƿ (Сŵ) ã
+// ĴСҵһװµļһ˾ļ裬 OS_MEM_CLASS_NUM 
+// ڱھ̬ʼãos_init ֮ǰҲû
+// ============================================================
+volatile uint32_t os_mem_heap_fallbacks = 0;
+volatile uint32_t os_mem_bad_frees = 0;
+
+#if OS_MEM_POOL_ENABLE
+
+#define OS_MEM_CLASS_NUM 4
+
+// TCB ҪܷŽ 1  (TCB ֶγĻͱȥ OS_MEM_CLASS1_SIZE)
+typedef char os_mem_tcb_fits_class1[(sizeof(task_tcb) <= OS_MEM_CLASS1_SIZE) ? 1 : -1];
+
+//  0 ļҲø 1 Ԫ (C Ϊ 0 )һԪزᱻõ
+#define OS_MEM_CLASS_WORDS(size, count)  ((count) != 0 ? MEM_POOL_WORDS(size, count) : 1)
+
+static uint64_t os_mem_class0[OS_MEM_CLASS_WORDS(OS_MEM_CLASS0_SIZE, OS_MEM_CLASS0_COUNT)];
+static uint64_t os_mem_class1[OS_MEM_CLASS_WORDS(OS_MEM_CLASS1_SIZE, OS_MEM_CLASS1_COUNT)];
+static uint64_t os_mem_class2[OS_MEM_CLASS_WORDS(OS_MEM_CLASS2_SIZE, OS_MEM_CLASS2_COUNT)];
+static uint64_t os_mem_class3[OS_MEM_CLASS_WORDS(OS_MEM_CLASS3_SIZE, OS_MEM_CLASS3_COUNT)];
+
+static mem_pool_t os_mem_pools[OS_MEM_CLASS_NUM] =
+{
+    MEM_POOL_INITIALIZER("os_mem0", os_mem_class0, OS_MEM_CLASS0_SIZE, OS_MEM_CLASS0_COUNT),
+    MEM_POOL_INITIALIZER("os_mem1", os_mem_class1, OS_MEM_CLASS1_SIZE, OS_MEM_CLASS1_COUNT),
+    MEM_POOL_INITIALIZER("os_mem2", os_mem_class2, OS_MEM_CLASS2_SIZE, OS_MEM_CLASS2_COUNT),
+    MEM_POOL_INITIALIZER("os_mem3", os_mem_class3, OS_MEM_CLASS3_SIZE, OS_MEM_CLASS3_COUNT),
+};
+
+//  size ֽ (õĿ 8 ֽڶ)û˷ NULL
+void* os_mem_alloc(uint32_t size)
+{
+    uint32_t i;
+    void *p;
+
+    for (i = 0; i < OS_MEM_CLASS_NUM; i++)
+    {
+        if (os_mem_pools[i].block_size < size || os_mem_pools[i].block_count == 0) continue;
+
+        p = mem_pool_alloc(&os_mem_pools[i]);
+        if (p != NULL) return p;
+    }
+
+#if OS_MEM_HEAP_FALLBACK
+    // ûкʵĿ飺˻ض (ǳʱ䣬ֻڳʼ׶η)
+    {
+        uint32_t old = os_isr_mask();
+        os_mem_heap_fallbacks++;
+        os_isr_unmask(old);
+    }
+    return malloc(size);
+#else
+    return NULL;
+#endif
+}
+
+// һͷʧ
+static void os_mem_bad_free(void)
+{
+    uint32_t old = os_isr_mask();
+    os_mem_bad_frees++;
+    os_isr_unmask(old);
+}
+
+void os_mem_free(void *p)
+{
+    uint32_t i;
+
+    if (p == NULL) return;
+
+    for (i = 0; i < OS_MEM_CLASS_NUM; i++)
+    {
+        if (mem_pool_contains(&os_mem_pools[i], p))
+        {
+            // ظͷšû뵽ͷӾգһ (ʱ¶ϵ)
+            if (mem_pool_free(&os_mem_pools[i], p) != OS_OK)
+            {
+                os_mem_bad_free();
+            }
+            return;
+        }
+    }
+
+#if OS_MEM_HEAP_FALLBACK
+    free(p);
+#else
+    // ˻ضѵĻڳָ벻 os_mem_alloc 
+    os_mem_bad_free();
+#endif
+}
+
+// صͳƣд stats[] ĸ
+uint32_t os_mem_stats(mem_pool_stats_t *stats, uint32_t max_pools)
+{
+    uint32_t i;
+
+    for (i = 0; i < OS_MEM_CLASS_NUM && i < max_pools; i++)
+    {
+        mem_pool_get_stats(&os_mem_pools[i], &stats[i]);
+    }
+    return i;
+}
+
+#else
+
+// صڴأں˶ֱ malloc (ǰһ)
+void* os_mem_alloc(uint32_t size)
+{
+    return malloc(size);
+}
+
+void os_mem_free(void *p)
+{
+    free(p);
+}
+
+uint32_t os_mem_stats(mem_pool_stats_t *stats, uint32_t max_pools)
+{
+    (void)stats;
+    (void)max_pools;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __MEM_POOL_H
+#define __MEM_POOL_H
+
+#include <stdint.h>
+#include "os_config.h"
+
+// ============================================================
+// ڴأһڴгһĿ飬/ͷŶ O(1)ж
+// пԼɵ (ͷ 4 ֽڴһп)
+// ûùĿ鲻Ԥȴ˳ fresh УԳʼҲ O(1)
+// ============================================================
+typedef struct
+{
+    void *free_list;            // ͷŻĿ
+    uint8_t *fresh;             // ûгȥĿ￪ʼ
+    uint8_t *start;             // صڴ淶Χ [start, end)
+    uint8_t *end;
+    uint32_t block_size;        // С (ֽڣ8 ı)
+    uint32_t block_count;       // ܿ
+    uint32_t used;              // ǰõĿ
+    uint32_t peak;              // õʱõ˼
+    uint32_t fail_count;        // ʧ (ؿ) Ĵ
+    char *name;
+} mem_pool_t;
+
+// ͳƿ
+typedef struct
+{
+    char *name;
+    uint32_t block_size;
+    uint32_t block_count;
+    uint32_t used;
+    uint32_t peak;
+    uint32_t fail_count;
+} mem_pool_stats_t;
+
+// ̬һ (õ mem_pool_init)
+//     static uint64_t rx_pool_mem[MEM_POOL_WORDS(64, 16)];
+//     static mem_pool_t rx_pool = MEM_POOL_INITIALIZER("rx", rx_pool_mem, 64, 16);
+#define MEM_POOL_WORDS(block_size, block_count) \
+    ((((block_size) + 7u) / 8u) * (block_count))
+#define MEM_POOL_INITIALIZER(name, mem, block_size, block_count) \
+    { 0, (uint8_t *)(mem), (uint8_t *)(mem), (uint8_t *)(mem) + (((block_size) + 7u) & ~7u) * (block_count), \
+      ((block_size) + 7u) & ~7u, (block_count), 0, 0, 0, (name) }
+
+int mem_pool_init(mem_pool_t *pool, char *name, void *mem, uint32_t block_size, uint32_t block_count);
+void* mem_pool_alloc(mem_pool_t *pool);
+int mem_pool_free(mem_pool_t *pool, void *block);
+uint32_t mem_pool_contains(mem_pool_t *pool, void *p);
+void mem_pool_get_stats(mem_pool_t *pool, mem_pool_stats_t *stats);
+
+// ں˶ (TCBջźȿƿ) õڴ棬 os_config.h ĿСּ
+extern volatile uint32_t os_mem_heap_fallbacks;  // û顢˻ malloc Ĵ
+extern volatile uint32_t os_mem_bad_frees;       // os_mem_free ͷʧ (ظͷšں˳ظȥָ) Ĵ
+
+void* os_mem_alloc(uint32_t size);
+void os_mem_free(void *p);
+uint32_t os_mem_stats(mem_pool_stats_t *stats, uint32_t max_pools);
+
+#endif
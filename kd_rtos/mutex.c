@@ -0,0 +1,371 @@
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "event.h"
+#include "mem_pool.h"
+
+// ============================================================
+// ڲ
+// ============================================================
+
+// ҵߵ
+static void mutex_held_add(task_tcb *tcb, mutex_t *mutex)
+{
+    mutex->held_next = tcb->held_mutex;
+    tcb->held_mutex = mutex;
+}
+
+// ӳߵժ
+static void mutex_held_remove(task_tcb *tcb, mutex_t *mutex)
+{
+    mutex_t **pp = &tcb->held_mutex;
+
+    while (*pp != NULL)
+    {
+        if (*pp == mutex)
+        {
+            *pp = mutex->held_next;
+            break;
+        }
+        pp = &(*pp)->held_next;
+    }
+    mutex->held_next = NULL;
+}
+
+// ȴȼߵ (ͬȼȡ)O(1)
+static task_tcb* mutex_highest_waiter(mutex_t *mutex)
+{
+    return wait_queue_peek(&mutex->wait_queue);
+}
+
+// ============================================================
+// ȼ̳
+// ============================================================
+
+#if OS_MUTEX_INHERIT_ENABLE && OS_EDF_ENABLE
+// EDF ƵϵĽֹʱ̳Уȼһ ( OS_EDF_PRIORITY)ȼûã
+// ðѵȴߵĽֹʱҲȥȻƵ EDF ȫڳǰ
+// ֹʱ = Լ (EDF )  EDF ƵεȴǸ
+static void mutex_deadline_update(task_tcb *tcb)
+{
+    mutex_t *mutex;
+    task_tcb *waiter;
+    list_t *bucket;
+    list_node_t *node;
+    uint32_t deadline = 0;
+    uint32_t found = 0;
+    uint32_t i;
+
+    if (tcb->task_options & TASK_OPT_EDF)
+    {
+        deadline = tcb->period_release + tcb->period_deadline;
+        found = 1;
+    }
+
+    for (mutex = tcb->held_mutex; mutex != NULL; mutex = mutex->held_next)
+    {
+        waiter = mutex_highest_waiter(mutex);
+        if (waiter == NULL || waiter->task_priority != OS_EDF_PRIORITY) continue;
+
+        // ͰﰴȼӸߵţEDF Ƶεĵȴ߶Ͱͷ
+        bucket = (list_t *)waiter->status_node.container;
+        node = bucket->head;
+        for (i = 0; i < bucket->count; i++)
+        {
+            waiter = (task_tcb *)node->owner_tcb;
+            if (waiter->task_priority != OS_EDF_PRIORITY) break;
+            if (!found || DEADLINE_BEFORE(waiter->edf_deadline, deadline))
+            {
+                deadline = waiter->edf_deadline;
+                found = 1;
+            }
+            node = node->next;
+        }
+    }
+
+    if (found)
+    {
+        edf_set_deadline(tcb, deadline);
+    }
+}
+#endif
+
+// ¼ʵȼ = max(ԭʼȼ, ĵȴߵȼ)
+//  EDF ƵεĻֹʱҲһ
+// (CPU Ԥ㽵/ָҲԲ static)
+void mutex_priority_update(task_tcb *tcb)
+{
+    uint32_t prio = tcb->base_priority;
+
+#if OS_MUTEX_INHERIT_ENABLE
+    mutex_t *mutex;
+    for (mutex = tcb->held_mutex; mutex != NULL; mutex = mutex->held_next)
+    {
+        task_tcb *waiter = mutex_highest_waiter(mutex);
+        if (waiter != NULL && waiter->task_priority > prio)
+        {
+            prio = waiter->task_priority;
+        }
+    }
+
+#if OS_EDF_ENABLE
+    // Ȱѽֹʱ䶨ãtask_priority_set  EDF Ƶʱŵö
+    if (prio == OS_EDF_PRIORITY)
+    {
+        mutex_deadline_update(tcb);
+    }
+#endif
+#endif
+
+    task_priority_set(tcb, prio);
+}
+
+// ѵȴߵȼ " -> " һ·ȥ (ݼ̳)
+// A  B B ڵ C ô B  C Ҫᵽ A ȼ
+// A  EDF ƵεĻB  C Ҫ̳ A Ľֹʱ
+static void mutex_inherit(mutex_t *mutex, task_tcb *waiter)
+{
+#if OS_MUTEX_INHERIT_ENABLE
+    task_tcb *owner = mutex->owner;
+    uint32_t prio = waiter->task_priority;
+
+    // ֻѾ () ľͣ (˳ֹɻʱתȦ)
+    while (owner != NULL)
+    {
+        if (owner->task_priority < prio)
+        {
+#if OS_EDF_ENABLE
+            if (prio == OS_EDF_PRIORITY)
+            {
+                edf_set_deadline(owner, waiter->edf_deadline);
+            }
+#endif
+            task_priority_set(owner, prio);
+        }
+#if OS_EDF_ENABLE
+        else if (prio == OS_EDF_PRIORITY && owner->task_priority == prio
+                 && DEADLINE_BEFORE(waiter->edf_deadline, owner->edf_deadline))
+        {
+            edf_set_deadline(owner, waiter->edf_deadline);
+        }
+#endif
+        else
+        {
+            break;
+        }
+
+        if (owner->wait_mutex == NULL) break;
+        owner = owner->wait_mutex->owner;
+    }
+#else
+    (void)mutex;
+    (void)waiter;
+#endif
+}
+
+// ============================================================
+// 1. 
+// ============================================================
+mutex_t* mutex_create(void)
+{
+    mutex_t *mutex = (mutex_t *)os_mem_alloc(sizeof(mutex_t));
+    if (mutex == NULL) return NULL;
+
+    mutex->type = EVENT_TYPE_MUTEX;
+    wait_queue_init(&mutex->wait_queue);
+    mutex->owner = NULL;
+    mutex->lock_count = 0;
+    mutex->held_next = NULL;
+
+    return mutex;
+}
+
+// ============================================================
+// 2. ɾ
+// ============================================================
+void mutex_delete(mutex_t *mutex)
+{
+    task_tcb *owner, *waiter;
+
+    if (mutex == NULL) return;
+
+    task_enter_critical();
+
+    // 峡еȴ
+    while ((waiter = wait_queue_peek(&mutex->wait_queue)) != NULL)
+    {
+        wait_queue_take(&mutex->wait_queue, waiter, OS_ERR_DELETED);
+        waiter->wait_mutex = NULL;
+        task_ready_insert(waiter);
+    }
+
+    // ߼̳ȼҪȥ
+    owner = mutex->owner;
+    if (owner != NULL)
+    {
+        mutex_held_remove(owner, mutex);
+        mutex_priority_update(owner);
+    }
+    os_mem_free(mutex);
+
+    if (OSSchedLockNesting == 0) SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    task_exit_critical();
+}
+
+// ============================================================
+// 3.  (ֵ֧ݹ)
+// ž˯ͬʱѳߵȼ
+//  0 ɹ-1 ʧ (סʱ)
+// ============================================================
+int mutex_lock(mutex_t *mutex)
+{
+    return mutex_lock_timeout(mutex, OS_WAIT_FOREVER);
+}
+
+// ============================================================
+// ʱļ
+// timeout: ȶٸ Tick (OS_NO_WAIT ȣOS_WAIT_FOREVER һֱ)
+//  OS_OK õˣOS_ERR_TIMEOUT ʱOS_ERR_DELETED ɾˣOS_ERR /ס
+// ============================================================
+int mutex_lock_timeout(mutex_t *mutex, uint32_t timeout)
+{
+    int result;
+
+    if (mutex == NULL) return OS_ERR;
+
+    task_enter_critical();
+
+    // --- Aûãֱ ---
+    if (mutex->owner == NULL)
+    {
+        mutex->owner = current_tcb;
+        mutex->lock_count = 1;
+        mutex_held_add(current_tcb, mutex);
+        task_exit_critical();
+        return 0;
+    }
+
+    // --- BԼѾţݹ ---
+    if (mutex->owner == current_tcb)
+    {
+        mutex->lock_count++;
+        task_exit_critical();
+        return 0;
+    }
+
+    // --- Cţ ---
+    if (timeout == OS_NO_WAIT)
+    {
+        task_exit_critical();
+        return OS_ERR_TIMEOUT;
+    }
+
+    // --- Dţȥ˯ ---
+    // ˣϽ
+    if (OSSchedLockNesting > 0)
+    {
+        task_exit_critical();
+        return OS_ERR;
+    }
+
+    // 1. ӾбƳȴ (ʱĻͬʱʱ) (˳ٽ)
+    wait_queue_block(&mutex->wait_queue, timeout);
+    current_tcb->wait_mutex = mutex;
+
+    // 2. ȼ̳Уѳ (Լڵȵĳ...) ᵽҵȼ
+    mutex_inherit(mutex, current_tcb);
+
+    task_exit_critical();
+
+    // ...  ...
+    // ... mutex_unlock ֱӰٻ (߳ʱ) ...
+
+    task_enter_critical();
+    result = current_tcb->wait_result;
+    if (result == OS_ERR_TIMEOUT)
+    {
+        // ʱTick ѾǴӵȴժˣ
+        // ΪǼ̳ȼҪȥ (ûҪô)
+        //  mutex_inherit һ " -> " ߣ
+        // ԼҲڵȱĻǰĳҲǴ̳еģɽԶ
+        task_tcb *owner;
+
+        current_tcb->wait_mutex = NULL;
+        owner = mutex->owner;
+        while (owner != NULL)
+        {
+            mutex_priority_update(owner);
+            if (owner->wait_mutex == NULL) break;
+            owner = owner->wait_mutex->owner;
+        }
+    }
+    task_exit_critical();
+
+    return result;
+}
+
+// ============================================================
+// 4. 
+// ڵȾͰֱӽȼߵǸȻָԼȼ
+//  0 ɹ-1 ʧ (ǳ)
+// ============================================================
+int mutex_unlock(mutex_t *mutex)
+{
+    task_tcb *waiter;
+    uint32_t old_prio;
+
+    if (mutex == NULL) return -1;
+
+    task_enter_critical();
+
+    if (mutex->owner != current_tcb)
+    {
+        task_exit_critical();
+        return -1;
+    }
+
+    // ݹû⵽
+    if (--mutex->lock_count > 0)
+    {
+        task_exit_critical();
+        return 0;
+    }
+
+    mutex_held_remove(current_tcb, mutex);
+    waiter = mutex_highest_waiter(mutex);
+
+    if (waiter != NULL)
+    {
+        // A. ֱӽȴ (ֹ˰·)
+        wait_queue_take(&mutex->wait_queue, waiter, OS_OK);
+        waiter->wait_mutex = NULL;
+        mutex->owner = waiter;
+        mutex->lock_count = 1;
+        mutex_held_add(waiter, mutex);
+
+        // B. ³ҲҪ̳ʣµĵȴ
+        mutex_priority_update(waiter);
+    }
+    else
+    {
+        mutex->owner = NULL;
+    }
+
+    // C. ָԼȼ (űĻֻЩҪĸ߶)
+    old_prio = current_tcb->task_priority;
+    mutex_priority_update(current_tcb);
+
+    // D. ³ߣʸռŴ (ҪԼ֮Ƚ)
+    if (waiter != NULL)
+    {
+        task_ready_wake(waiter);
+    }
+
+    // E. Լˣб˱Ҹˣõ¿һ
+    if (current_tcb->task_priority < old_prio && OSSchedLockNesting == 0)
+    {
+        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    }
+
+    task_exit_critical();
+    return 0;
+}
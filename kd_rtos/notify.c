@@ -2,54 +2,147 @@
 #include "event.h"
 #include "list.h"
 #include "scheduler.h"
+#include "os_delay.h"
 
 extern list_t ReadyList[MAX_PRIORITY];
+
+static int task_notify_locked(task_tcb *target_tcb, uint32_t index, uint32_t value, uint32_t action);
+
 // ============================================================
 // ֪ͨ (Give / Send)
-// ֱӰֵдĿ TCB
+// ֱӰֵдĿ TCB (0 䣬)
 // ============================================================
 void task_notify(task_tcb *target_tcb, uint32_t value)
 {
-    if (target_tcb == NULL) return;
+    (void)task_notify_ex(target_tcb, 0, value, NOTIFY_ACTION_OVERWRITE);
+}
+
+// жϰ棺ѵҪж˳ (os_isr_exit) йȥ
+void task_notify_from_isr(task_tcb *target_tcb, uint32_t value)
+{
+    (void)task_notify_ex_from_isr(target_tcb, 0, value, NOTIFY_ACTION_OVERWRITE);
+}
+
+// ============================================================
+// ֪ͨ ()
+// index:  ڼ (0 ~ OS_TASK_NOTIFY_SLOTS-1)
+// action: NOTIFY_ACTION_SET_BITS / INCREMENT / OVERWRITE / NO_OVERWRITE / NONE
+//  OS_OK ɹOS_ERR  (ʶ action)  NO_OVERWRITE ʱһ֪ͨûȡ
+// ============================================================
+int task_notify_ex(task_tcb *target_tcb, uint32_t index, uint32_t value, uint32_t action)
+{
+    int result;
+
+    if (target_tcb == NULL || index >= OS_TASK_NOTIFY_SLOTS || action > NOTIFY_ACTION_NO_OVERWRITE) return OS_ERR;
 
     task_enter_critical();
+    result = task_notify_locked(target_tcb, index, value, action);
+    task_exit_critical();
+
+    return result;
+}
+
+// жϰ
+int task_notify_ex_from_isr(task_tcb *target_tcb, uint32_t index, uint32_t value, uint32_t action)
+{
+    uint32_t mask;
+    int result;
+
+    if (target_tcb == NULL || index >= OS_TASK_NOTIFY_SLOTS || action > NOTIFY_ACTION_NO_OVERWRITE) return OS_ERR;
+
+    mask = os_isr_mask();
+    result = task_notify_locked(target_tcb, index, value, action);
+    os_isr_unmask(mask);
+
+    return result;
+}
+
+// task_notify  (߸ٽ)
+static int task_notify_locked(task_tcb *target_tcb, uint32_t index, uint32_t value, uint32_t action)
+{
+    uint8_t old_state = target_tcb->notify_state[index];
+
+    // 1. д
+    switch (action)
+    {
+    case NOTIFY_ACTION_SET_BITS:
+        target_tcb->notify_value[index] |= value;
+        break;
+
+    case NOTIFY_ACTION_INCREMENT:
+        target_tcb->notify_value[index]++;
+        break;
+
+    case NOTIFY_ACTION_OVERWRITE:
+        target_tcb->notify_value[index] = value;
+        break;
+
+    case NOTIFY_ACTION_NO_OVERWRITE:
+        // һŻûȡߣܸ
+        if (old_state == NOTIFY_PENDING) return OS_ERR;
+        target_tcb->notify_value[index] = value;
+        break;
 
-    // 1. д (ʾ򵥵ĸģʽ)
-    target_tcb->notify_value = value;
+    case NOTIFY_ACTION_NONE: // ֻ
+        break;
+
+    default: // ʶĶ (ѾһΣ)
+        return OS_ERR;
+    }
 
     // 2. ״̬
     // ۶ԷǷڵȣȰŷŽȥ
     // Է֮ǰ NOTIFY_NONEڱ NOTIFY_PENDING
     // Է֮ǰ NOTIFY_WAITING NOTIFY_PENDING 
+    target_tcb->notify_state[index] = NOTIFY_PENDING;
 
-    // 3. ĿǷɵ֪ͨ
-    if (target_tcb->notify_state == NOTIFY_WAITING)
+    // 3. ĿǷɵ䣿
+    if (old_state == NOTIFY_WAITING)
     {
         // Ŀ˯ȴѣ
-        // A. ״̬Ϊ (Pending)
-        target_tcb->notify_state = NOTIFY_PENDING;
+        // A. ʱĵȴûӴʱϳ
+        os_delay_cancel(target_tcb);
+        target_tcb->wait_result = OS_OK;
 
-        // B. б (Ϊڵ֪ͨ϶ھ)
-        // ע⣺޵ȴ(ûDelayedList)Ǵʱģ
-        // Ҫȴ DelayedList Ƴ򻯴ֻ޵ȴѡ
-        list_insert_end(&ReadyList[target_tcb->task_priority], &target_tcb->status_node);
+        // B. б (Ϊڵ֪ͨ϶ھ)ָλͼ
+        //    ȼǰռֵŴ (ռ)
+        task_ready_wake(target_tcb);
+    }
 
-        // C. ָλͼ
-        bitmap_set(target_tcb->task_priority);
+    return OS_OK;
+}
 
-        // D.  (ռ)
-        if (OSSchedLockNesting == 0)
-        {
-            SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-        }
-    }
-    else
-    {
-        // ԷûڵȣУǾֻ״̬Ϊš
-        target_tcb->notify_state = NOTIFY_PENDING;
-    }
+// ============================================================
+// ǰ index ˯ (ٽұ֤û)
+// ʱٽֵ OS_OK ()  OS_ERR_TIMEOUT
+// ============================================================
+static int notify_block(uint32_t index, uint32_t timeout)
+{
+    // 1. Լ״̬ڵ
+    current_tcb->notify_state[index] = NOTIFY_WAITING;
+    current_tcb->notify_wait_index = (uint8_t)index;
+    current_tcb->wait_result = OS_OK;
 
-    task_exit_critical();
+    // 2. ӾбƳ (ժ)
+    task_ready_remove(current_tcb);
+
+    // ע⣺ǲκεȴ list
+    // Ǳˡ»Ұֻг TCB ָķܾǻ
+    // (Ϊʲô Direct to Task)
+    // ʱĻֻʱϹһ (delay_node) Tick ǷŻ
+    os_delay_arm(current_tcb, timeout);
+
+    // 3. 
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    task_exit_critical(); // ǰж
+
+    // -----------------------------------------------
+    // ﱻ......
+    // ֱ task_notify ӻ ReadyList (߳ʱ)Ż
+    // -----------------------------------------------
+
+    task_enter_critical();
+    return current_tcb->wait_result;
 }
 
 // ============================================================
@@ -60,47 +153,117 @@ uint32_t task_wait_notify(void)
 {
     uint32_t val = 0;
 
-    if (OSSchedLockNesting > 0) return 0; // סܵ
+    (void)task_wait_notify_timeout(&val, OS_WAIT_FOREVER);
+    return val;
+}
+
+// ============================================================
+// ʱĵȴ֪ͨ (0 )
+// timeout: ȶٸ Tick (OS_NO_WAIT ȣOS_WAIT_FOREVER һֱ)
+//  OS_OK յ (ֵ *value)OS_ERR_TIMEOUT ʱOS_ERR סܵ
+// ============================================================
+int task_wait_notify_timeout(uint32_t *value, uint32_t timeout)
+{
+    return task_wait_notify_ex(0, 0, 0, value, timeout);
+}
+
+// ============================================================
+// ȴ֪ͨ ()
+// index:          ȵڼ
+// clear_on_entry: ûšҪȥ֮ǰȰֵЩλ
+// clear_on_exit:  յԺ (ֵѾ *value)ֵЩλ
+//                 (¼ãclear_on_exit  0xFFFFFFFFÿλ)
+//  OS_OK յˣOS_ERR_TIMEOUT ʱOS_ERR /סܵ
+// ============================================================
+int task_wait_notify_ex(uint32_t index, uint32_t clear_on_entry, uint32_t clear_on_exit,
+                        uint32_t *value, uint32_t timeout)
+{
+    int result;
+
+    if (index >= OS_TASK_NOTIFY_SLOTS) return OS_ERR;
 
     task_enter_critical();
 
-    // ---  A: Ѿ ---
-    if (current_tcb->notify_state == NOTIFY_PENDING)
+    // ---  A: յģ˯ȥ ---
+    if (current_tcb->notify_state[index] != NOTIFY_PENDING)
     {
-        val = current_tcb->notify_value;    // 
-        current_tcb->notify_state = NOTIFY_NONE; // ձ־
+        current_tcb->notify_value[index] &= ~clear_on_entry;
+
+        if (timeout == OS_NO_WAIT)
+        {
+            task_exit_critical();
+            return OS_ERR_TIMEOUT;
+        }
+        if (OSSchedLockNesting > 0) // סܵ
+        {
+            task_exit_critical();
+            return OS_ERR;
+        }
+
+        // 󣺳ʱ Tick Ѿ״̬λ
+        result = notify_block(index, timeout);
+        if (result != OS_OK)
+        {
+            task_exit_critical();
+            return result;
+        }
     }
-    // ---  B: յģ˯ȥ ---
-    else
+
+    // ---  B:  (У߸ձ) ---
+    if (value != NULL) *value = current_tcb->notify_value[index]; // 
+    current_tcb->notify_value[index] &= ~clear_on_exit;
+    current_tcb->notify_state[index] = NOTIFY_NONE; // ձ־
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// ============================================================
+// ֪ͨź ( NOTIFY_ACTION_INCREMENT )
+// ֵ 0 ͵ȣõ clear=0  1 (ź)clear=1  (ֵź)
+// value: ֮ǰֵ浽 (Ŀ NULL)
+//  OS_OK õˣOS_ERR_TIMEOUT ʱ ( OS_NO_WAIT ʱֵ 0)
+//      OS_ERR /סܵ
+// ============================================================
+int task_notify_take(uint32_t index, uint32_t clear, uint32_t *value, uint32_t timeout)
+{
+    uint32_t count;
+    int result = OS_OK;
+
+    if (index >= OS_TASK_NOTIFY_SLOTS) return OS_ERR;
+
+    task_enter_critical();
+
+    if (current_tcb->notify_value[index] == 0)
     {
-        // 1. Լ״̬ڵ
-        current_tcb->notify_state = NOTIFY_WAITING;
+        if (timeout == OS_NO_WAIT)
+        {
+            task_exit_critical();
+            return OS_ERR_TIMEOUT;
+        }
+        if (OSSchedLockNesting > 0) // סܵ
+        {
+            task_exit_critical();
+            return OS_ERR;
+        }
 
-        // 2. ӾбƳ (ժ)
-        list_remove(&ReadyList[current_tcb->task_priority], &current_tcb->status_node);
-        if (ReadyList[current_tcb->task_priority].head == NULL)
+        result = notify_block(index, timeout);
+        if (result != OS_OK)
         {
-            bitmap_clear(current_tcb->task_priority);
+            task_exit_critical();
+            return result;
         }
+    }
 
-        // ע⣺ǲ DelayedListҲκ list
-        // Ǳˡ»Ұֻг TCB ָķܾǻ
-        // (Ϊʲô Direct to Task)
-
-        // 3. 
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-        task_exit_critical(); // ǰж
-
-        // -----------------------------------------------
-        // ﱻ......
-        //ֱ os_task_notify ӻ ReadyListŻ
-        // -----------------------------------------------
-        // 4.  (϶)
-        task_enter_critical();
-        val = current_tcb->notify_value;     // 
-        current_tcb->notify_state = NOTIFY_NONE; // λ
+    //  (У߸ձ)
+    count = current_tcb->notify_value[index];
+    if (count != 0)
+    {
+        current_tcb->notify_value[index] = clear ? 0 : (count - 1);
     }
+    current_tcb->notify_state[index] = NOTIFY_NONE;
+    if (value != NULL) *value = count;
 
     task_exit_critical();
-    return val;
+    return result;
 }
@@ -0,0 +1,145 @@
+#ifndef __OS_CONFIG_H
+#define __OS_CONFIG_H
+
+// ====================================================
+// ں (ĿҪ޸ҪȥںԴ)
+// ====================================================
+
+//*ȼ (ԽȼԽߣ0 )
+// λͼ ( + ) 32 x 32 = 1024 ʼ CLZ
+// ȡ 32 ReadyList ҲС
+#define MAX_PRIORITY              32
+
+//*ջ (λ/4ֽ)
+#define IDLE_TASK_STACK_DEPTH     128
+
+//*Tickless ͹ģʽ1=, 0=ر
+// 󣬿 SysTick ĳһԶʱֱ˯һʱ
+#define OS_TICKLESS_ENABLE        1
+
+//*Ԥƿô Tick Ͳ Tickless (ر̶ʱҲп)
+#define OS_TICKLESS_MIN_TICKS     2
+
+//*ʱʱֵĲ ( 2 )
+// Խ࣬ÿҵԽ٣os_delay Խ
+#define OS_TICK_WHEEL_SIZE        64
+
+//*ȼ̳У1=, 0=ر (رպһͨĵݹԱȼת)
+#define OS_MUTEX_INHERIT_ENABLE   1
+
+//*ĬʱƬ (λTick)ͬȼһʱƬֵһ
+// ÿ񻹿 task_set_time_slice 
+#define OS_TIME_SLICE_TICKS       1
+
+//*EDF (ֹʱ) ࣺ1=, 0=ر
+#define OS_EDF_ENABLE             1
+
+//*EDF ͳһȼ (Ƶ)ߵͨռ EDF 
+// ȼ EDF רãҪٴͨ
+#define OS_EDF_PRIORITY           (MAX_PRIORITY / 2)
+
+//*EDF ɲԵ (λǧ֮һ1000 = 100%)
+#define OS_EDF_UTIL_LIMIT         1000
+
+//*CPU Ԥ (ͻִʱ䣬ֹȼ)1=, 0=ر
+#define OS_BUDGET_ENABLE          1
+
+//*Ԥù⡢ѡ񽵼񽵵ȼ (Ҫȿ)
+#define OS_BUDGET_BG_PRIORITY     1
+
+//*IPC ȴеȼͰ (1 ~ 32)
+// ÿź//һȴУÿͰռ 8 ֽڣ
+// Ͱ MAX_PRIORITY ʱͬһͰֻͬȼһЩʡڴ桢Ͱڰȼ
+#define OS_WAIT_QUEUE_BUCKETS     8
+
+//*ź޾· (LDREX/STREX)1=, 0=ر
+// Դ sem_take û˵ȵ sem_give ٽ
+#define OS_SEM_FAST_PATH_ENABLE   1
+
+//*ںٽ BASEPRI εжȼ (NVIC ռȼ 0~15ԽСԽ)
+// ȼ >= ֵжϻᱻںٽסԵں API (sem_give ֮)
+//  < ֵж () Զᱻںӳ٣Բܵκں API
+#define OS_MAX_SYSCALL_PRIORITY   5
+
+//*ÿ֪ͨ (task_notify_ex  index Χ 0 ~ N-1 0  task_notify õǸ)
+// ÿһۣÿ TCB  5 ֽңͬ;òͬĲۣ಻
+#define OS_TASK_NOTIFY_SLOTS      2
+
+//*ʱ1=, 0=ر
+#define OS_TIMER_ENABLE           1
+
+//*ʱʱֵĲ ( 2 )
+#define OS_TIMER_WHEEL_SIZE       32
+
+//*ʱȼջ (ִеĶʱص)
+#define OS_TIMER_TASK_PRIORITY    (MAX_PRIORITY - 1)
+#define OS_TIMER_TASK_STACK_DEPTH 256
+
+//*ں˶ڴأ1=, 0=ر (رվͺǰһֱ malloc)
+// TCBջź//еȿƿ鶼С 4 ãͷŶǳʱ
+#define OS_MEM_POOL_ENABLE        1
+
+//*ûкʵĿʱ˻ malloc1=˻ (ջܽǳʱ), 0=ֱʧ (Ĭϣ NULL)
+// ĬϹţ֤ں˶ʱȷ os_mem_stats ķֵʧܴá
+// 򿪵Ļ os_mem_heap_fallbacks ˻˼
+#define OS_MEM_HEAP_FALLBACK      0
+
+//*4 صĿС (ֽڣС8 ı) Ϳ 0 ǲҪһ
+// ĬϰںԼû䣺
+//   0 ʱСƿ
+//   1 TCB (װ£ʱ) ź//ȿƿ
+//   2 128 ջ (񣬴 FPU ֡Ҳ) С
+//   3 256 ջ (ʱ񣬴 FPU ֡ 1160 ֽҲ)
+#define OS_MEM_CLASS0_SIZE        64
+#define OS_MEM_CLASS0_COUNT       8
+#define OS_MEM_CLASS1_SIZE        320
+#define OS_MEM_CLASS1_COUNT       16
+#define OS_MEM_CLASS2_SIZE        704
+#define OS_MEM_CLASS2_COUNT       8
+#define OS_MEM_CLASS3_SIZE        1280
+#define OS_MEM_CLASS3_COUNT       6
+
+// ====================================================
+// ü
+// ====================================================
+#if (MAX_PRIORITY < 2) || (MAX_PRIORITY > 1024)
+#error "MAX_PRIORITY  2 ~ 1024 ֮"
+#endif
+
+#if (OS_TICK_WHEEL_SIZE & (OS_TICK_WHEEL_SIZE - 1)) != 0
+#error "OS_TICK_WHEEL_SIZE  2 "
+#endif
+
+#if (OS_TASK_NOTIFY_SLOTS < 1) || (OS_TASK_NOTIFY_SLOTS > 255)
+#error "OS_TASK_NOTIFY_SLOTS  1 ~ 255 ֮"
+#endif
+
+#if OS_TIMER_ENABLE && ((OS_TIMER_WHEEL_SIZE & (OS_TIMER_WHEEL_SIZE - 1)) != 0)
+#error "OS_TIMER_WHEEL_SIZE  2 "
+#endif
+
+#if OS_TIMER_ENABLE && ((OS_TIMER_TASK_PRIORITY <= 0) || (OS_TIMER_TASK_PRIORITY >= MAX_PRIORITY))
+#error "OS_TIMER_TASK_PRIORITY ڿ MAX_PRIORITY ֮"
+#endif
+
+#if OS_MEM_POOL_ENABLE && ((OS_MEM_CLASS0_SIZE > OS_MEM_CLASS1_SIZE) || (OS_MEM_CLASS1_SIZE > OS_MEM_CLASS2_SIZE) || (OS_MEM_CLASS2_SIZE > OS_MEM_CLASS3_SIZE))
+#error "OS_MEM_CLASSx_SIZE С"
+#endif
+
+#if (OS_MAX_SYSCALL_PRIORITY < 1) || (OS_MAX_SYSCALL_PRIORITY > 15)
+#error "OS_MAX_SYSCALL_PRIORITY  1 ~ 15 ֮ (0 д BASEPRI ڲ)"
+#endif
+
+#if (OS_WAIT_QUEUE_BUCKETS < 1) || (OS_WAIT_QUEUE_BUCKETS > 32) || (OS_WAIT_QUEUE_BUCKETS > MAX_PRIORITY)
+#error "OS_WAIT_QUEUE_BUCKETS  1 ~ 32 ֮䣬Ҳܳ MAX_PRIORITY"
+#endif
+
+#if OS_EDF_ENABLE && ((OS_EDF_PRIORITY <= 0) || (OS_EDF_PRIORITY >= MAX_PRIORITY))
+#error "OS_EDF_PRIORITY ڿ MAX_PRIORITY ֮"
+#endif
+
+#if OS_BUDGET_ENABLE && ((OS_BUDGET_BG_PRIORITY <= 0) || (OS_BUDGET_BG_PRIORITY >= MAX_PRIORITY))
+#error "OS_BUDGET_BG_PRIORITY ڿ MAX_PRIORITY ֮"
+#endif
+
+#endif
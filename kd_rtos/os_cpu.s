@@ -11,6 +11,11 @@
     IMPORT  current_tcb             ; IMPORT: ⲿ (൱CԵ extern)
     IMPORT  next_tcb
     IMPORT  switch_context_logic
+    IMPORT  os_switch_account       ;  + CPU Ԥ㣬·Ҫ
+    IMPORT  PrioGroup               ; ·ֱӲλͼ
+    IMPORT  PrioBitmap
+    IMPORT  ReadyList
+    IMPORT  os_kernel_basepri       ; ںٽ BASEPRI ֵ (task.c ﰴ os_config.h )
 
     EXPORT  PendSV_Handler          ; EXPORT: ⲿ
     EXPORT  os_start
@@ -31,7 +36,8 @@ os_start
 
     ; --- ָļĴ ---
     ; [ָ] LDMIA: Load Multiple Increment After (ȡ/ջ)
-    LDMIA   R0!, {R4-R11}           ;  R4-R11R0ָӲ֡
+    LDMIA   R0!, {R4-R11}           ;  R4-R11
+    ADD     R0, R0, #4              ;  EXC_RETURN (һֶ""ģò)R0ָӲ֡
 
     ; --- л PSP ---
     ; [ָ] MSR: Move to Special Register (ͨüĴ -> Ĵ)
@@ -39,7 +45,7 @@ os_start
 
     ; [ָ] MOV: Move (ݸֵ/)
     MOV     R1, #2
-    MSR     CONTROL, R1             ; л PSP ģʽ
+    MSR     CONTROL, R1             ; л PSP ģʽ (˳ FPCAmain ùĸֳ)
 
     ; [ָ] ISB: Instruction Synchronization Barrier (ָͬ/ϴˮ)
     ISB                             ; ָͬ
@@ -61,9 +67,50 @@ os_start
 ;========================================================================
 ; : PendSV_Handler
 ; : л (Task A <-> Task B)
+; ·ȼĶͷǵǰ ( Tick ѵǰ)
+;          ֱӷأ/ָĴҲѡ C 
+;          (ֻл switch_context_logicռֵ洦)
+; ȵ os_switch_accountCPU ˺Ԥ鲻вжҪ
+;          ԤùⱻĻλͼʱѾǽԺľ״̬
+;  BASEPRI  CPSID OS_MAX_SYSCALL_PRIORITY жлڼܽ
+; 㣺Ӳѹջ (FPCCR.LSPEN)EXC_RETURN  4 λΪ 0 ˵ù FPU
+;       ֻŶⱣ/ָ S16-S31л
+; ֡ (͵ַ -> ߵַ)R4-R11, EXC_RETURN, [S16-S31]
+; !!! Ľṹ岼֣list_t = {head, count} ռ 8 ֽڣlist_node_t.owner_tcb ƫ 8
+;     task_tcb.stack_ptr ƫ 0⼸ṹʱҪͬ (scheduler.c бڼ) !!!
 ;========================================================================
 PendSV_Handler
-    CPSID   I                       ; ж
+    ; [ָ] MSR BASEPRI: ȼڸֵж
+    LDR     R0, =os_kernel_basepri
+    LDR     R0, [R0]
+    MSR     BASEPRI, R0             ; ں˹ܵõж
+    DSB
+    ISB
+
+    ; --- ˺Ԥ (C) ---
+    PUSH    {R3, R14}               ;  LR ( R3 չ 8 ֽڣջ)
+    BL      os_switch_account
+    POP     {R3, R14}
+
+    ; --- ·λͼҳȼĶͷ ---
+    ; [ָ] CLZ: Count Leading Zeros (ǰ 031 - CLZ λλ)
+    LDR     R1, =PrioGroup
+    LDR     R1, [R1]
+    CLZ     R1, R1
+    RSB     R1, R1, #31             ; R1 = ߵ
+    LDR     R2, =PrioBitmap
+    LDR     R2, [R2, R1, LSL #2]    ; R2 = PrioBitmap[]
+    CLZ     R2, R2
+    RSB     R2, R2, #31
+    ADD     R1, R2, R1, LSL #5      ; R1 = ȼ =  * 32 + λ
+    LDR     R2, =ReadyList
+    LDR     R2, [R2, R1, LSL #3]    ; R2 = ReadyList[ȼ].head
+    LDR     R2, [R2, #8]            ; R2 = head->owner_tcb
+
+    LDR     R3, =current_tcb
+    LDR     R3, [R3]                ; R3 = current_tcb
+    CMP     R2, R3
+    BEQ     PendSV_Exit             ; ǵǰʲô
 
     ; --- 浱ǰ (Context Save) ---
     ; [ָ] MRS: Move From Special Register (Ĵ -> ͨüĴ)
@@ -72,25 +119,29 @@ PendSV_Handler
     ; [ָ] CBZ: Compare and Branch on Zero (Ϊ0ת)
     CBZ     R0, Switch_Point        ; ״б(ѡ)
 
-    ; [ָ] STMDB: Store Multiple Decrement Before (洢/ѹջ)
-    STMDB   R0!, {R4-R11}           ; ѹ R4-R11
+    ; ù FPU  (EXC_RETURN bit4 = 0) ű S16-S31
+    ; (ָͬʱᴥѹջӲ֡Ԥ S0-S15/FPSCR дȥ)
+    ; [ָ] TST: λ룬ֻ±־IT EQ: һִָ
+    TST     R14, #0x10
+    IT      EQ
+    VSTMDBEQ R0!, {S16-S31}
 
-    LDR     R1, =current_tcb        ; ջ TCB
-    LDR     R2, [R1]
+    ; [ָ] STMDB: Store Multiple Decrement Before (洢/ѹջ)
+    STMDB   R0!, {R4-R11, R14}      ; ѹ R4-R11  EXC_RETURN
 
     ; [ָ] STR: Store Register (Ĵ -> дڴ)
-    STR     R0, [R2]                ;  TCB е stack_ptr
+    STR     R0, [R3]                ;  current_tcb->stack_ptr
 
 Switch_Point
-    ; --- ִе㷨 (C) ---
+    ; --- ִе㷨 (Cԣռֵ) ---
     ; [ָ] PUSH: Push registers to stack (ѹ뵱ǰջ)
-    PUSH    {R14}                   ;  LR
+    PUSH    {R3, R14}               ;  LR ( R3 չ 8 ֽڣջ)
 
     ; [ָ] BL: Branch with Link (úصַ LR)
-    BL      switch_context_logic    ;  C  current_tcb
+    BL      switch_context_logic    ;  C  next_tcb
 
     ; [ָ] POP: Pop registers from stack (ӵǰջ)
-    POP     {R14}
+    POP     {R3, R14}
 
     ; --- л TCB ָ ---
     LDR     R1, =next_tcb           ; ȡ next_tcb
@@ -101,11 +152,18 @@ Switch_Point
 
     ; --- ָһ (Context Restore) ---
     LDR     R0, [R2]                ; ȡջ
-    LDMIA   R0!, {R4-R11}           ;  R4-R11
+    LDMIA   R0!, {R4-R11, R14}      ;  R4-R11 Լ EXC_RETURN
+
+    TST     R14, #0x10              ; ù FPU Ͱ S16-S31 Ҳָ
+    IT      EQ
+    VLDMIAEQ R0!, {S16-S31}
+
     MSR     PSP, R0                 ;  PSP
 
-    CPSIE   I                       ; ж
-    BX      R14                     ; ˳ж (ӲԶָʣĴ)
+PendSV_Exit
+    MOV     R0, #0
+    MSR     BASEPRI, R0             ; 
+    BX      R14                     ; ˳ж (Ӳ EXC_RETURN ԶָʣĴ֡Ҳ)
 
     ; [ָ] ALIGN: ȷһַָ (ָ)
     ALIGN
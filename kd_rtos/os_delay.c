@@ -3,10 +3,111 @@
 #include "task.h"
 #include "scheduler.h"
 #include "cpu_tick.h"
+#include "os_delay.h"
+#include "os_stats.h"
+#include "wait_queue.h"
+#include "os_timer.h"
 
 
 extern list_t ReadyList[MAX_PRIORITY];
 
+#define WHEEL_MASK  (OS_TICK_WHEEL_SIZE - 1)
+
+// ں Tick  (ÿ SysTick  1)
+volatile uint32_t os_tick_count = 0;
+
+// ʡ PendSV  ( Tick ûռʱƬҲû꣬Ͳȥл)
+volatile uint32_t os_pendsv_avoided = 0;
+
+// !!! ʱʱ (ԭ DelayedList) !!!
+// ڵľ Tick ɢеÿڲʣʱź
+// ÿ Tick ֻǰ۵ͷڵ㣬ֻڵ񣬲ٱ˯
+list_t DelayWheel[OS_TICK_WHEEL_SIZE];
+
+// ʼʱ ( os_init )
+void os_delay_init(void)
+{
+    int i;
+    for (i = 0; i < OS_TICK_WHEEL_SIZE; i++)
+    {
+        list_init(&DelayWheel[i]);
+    }
+    os_tick_count = 0;
+}
+
+uint32_t os_get_tick(void)
+{
+    return os_tick_count;
+}
+
+// ============================================================
+// ҵʱ (߸ж)
+// ֻһڲҲλãʱֻй
+// õ delay_nodeʱȴ IPC ͬʱڵȴ (status_node) ʱ
+// ============================================================
+static void delay_wheel_insert(task_tcb *tcb, uint32_t wake_tick)
+{
+    list_t *slot = &DelayWheel[wake_tick & WHEEL_MASK];
+    uint32_t remain = wake_tick - os_tick_count;
+    list_node_t *pos = slot->head;
+    uint32_t i;
+
+    tcb->delay_node.value = wake_tick;
+
+    // ʣʱͬһ Tick ڵģȼߵǰ (ʱȼ)
+    for (i = 0; i < slot->count; i++)
+    {
+        task_tcb *other = (task_tcb *)(pos->owner_tcb);
+        uint32_t other_remain = pos->value - os_tick_count;
+
+        if (other_remain > remain ||
+            (other_remain == remain && other->task_priority < tcb->task_priority))
+        {
+            break;
+        }
+        pos = pos->next;
+    }
+
+    list_insert_before(slot, (i < slot->count) ? pos : NULL, &tcb->delay_node);
+}
+
+// ============================================================
+// ȴĳʱ (ںڲã߸ж)
+// timeout  Tick OS_WAIT_FOREVER ʾ
+// ============================================================
+void os_delay_arm(task_tcb *tcb, uint32_t timeout)
+{
+    if (timeout == OS_WAIT_FOREVER) return;
+    if (timeout > OS_DELAY_MAX_TICKS) timeout = OS_DELAY_MAX_TICKS;
+    delay_wheel_insert(tcb, os_tick_count + timeout);
+}
+
+// ȵ (߶ɾ)ûӳ
+void os_delay_cancel(task_tcb *tcb)
+{
+    if (tcb->delay_node.container != NULL)
+    {
+        list_remove(tcb->delay_node.container, &tcb->delay_node);
+    }
+}
+
+// ˣڵʲôͰժǳʱ
+static void delay_timeout(task_tcb *tcb)
+{
+    if (tcb->wait_queue != NULL)
+    {
+        //  IPC ȴ (ź䡢...)
+        wait_queue_remove(tcb->wait_queue, tcb);
+        tcb->wait_result = OS_ERR_TIMEOUT;
+    }
+    else if (tcb->notify_state[tcb->notify_wait_index] == NOTIFY_WAITING)
+    {
+        // ڵ֪ͨ (κ)
+        tcb->notify_state[tcb->notify_wait_index] = NOTIFY_NONE;
+        tcb->wait_result = OS_ERR_TIMEOUT;
+    }
+}
+
 // ʱ
 void os_delay(uint32_t ticks)
 {
@@ -20,27 +121,171 @@ void os_delay(uint32_t ticks)
         return;
     }
 
-    // 1. ٽ
+    // ʱ޷ŲֵȽϣʱܳȦ
+    if (ticks > OS_DELAY_MAX_TICKS) ticks = OS_DELAY_MAX_TICKS;
+
+    // 1. ٽ (ʱٽ㣬 Tick ܸպ߹ȥ)
     task_enter_critical();
 
-    // 2. 
-    current_tcb->delay_ticks = ticks;
+    // 2. ӾбƳڵľ Tick ʱ֣
+    os_delay_to_tick(os_tick_count + ticks);
 
-    // 3. ӾбƳ
-    list_remove(&ReadyList[current_tcb->task_priority], &current_tcb->status_node);
+    // 3. ˳ٽ (PendSV ִ֮)
+    task_exit_critical();
+}
 
-    // 4. ȼûˣλͼ (ؼ)
-    if (ReadyList[current_tcb->task_priority].head == NULL)
+// ============================================================
+// ʱ *last_wake Ϊ˯ period  Tick *last_wake ǰһ
+// ѭͲΪԼִʱƯƣ
+//     uint32_t last = os_get_tick();
+//     while (1) { do_work(); os_delay_until(&last, 10); }
+// Ѿ˻ʱ (һָɻʱ) ֱӷأ˯
+// ============================================================
+void os_delay_until(uint32_t *last_wake, uint32_t period)
+{
+    uint32_t wake_tick;
+
+    if (last_wake == NULL || period == 0) return;
+
+    wake_tick = *last_wake + period;
+    *last_wake = wake_tick;
+
+    // סʱֻԭص (SysTick )
+    if (OSSchedLockNesting > 0)
     {
-        bitmap_clear(current_tcb->task_priority);
+        while ((int32_t)(wake_tick - os_tick_count) > 0);
+        return;
     }
 
-    // 5. ʱб ()
-    list_insert_end(&DelayedList, &current_tcb->status_node);
-
-    //6. ˳ٽ
+    task_enter_critical();
+    os_delay_to_tick(wake_tick);
     task_exit_critical();
+}
+
+// ============================================================
+// ˯ Tick wake_tick (ںڲ)
+// ߱Ѿٽұ֤ûб
+// ============================================================
+void os_delay_to_tick(uint32_t wake_tick)
+{
+    // ʱѾ (߾)˯
+    if ((int32_t)(wake_tick - os_tick_count) <= 0) return;
 
-    // 7.  (Ҳˣұ)
+    // 1. ӾбƳ (ȼû˻˳λͼ)
+    task_ready_remove(current_tcb);
+
+    // 2. ӣʱ
+    delay_wheel_insert(current_tcb, wake_tick);
+
+    // 3.  (Ҳˣұ)
     SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 }
+
+// ============================================================
+// ں Tick  ( SysTick_Handler )
+// ============================================================
+void os_tick_handler(void)
+{
+    list_t *slot;
+    uint32_t need_switch = 0;
+
+    os_tick_count++;
+
+    // ˳ǰһˣֹʱ䲻лʱ CYCCNT ƶ
+    os_stats_account();
+
+    // ============================================================
+    // !!! ʱָ
+    // ǰģڵһǰ
+    // ============================================================
+    slot = &DelayWheel[os_tick_count & WHEEL_MASK];
+
+    while (slot->head != NULL && slot->head->value == os_tick_count)
+    {
+        list_node_t *node = slot->head;
+        task_tcb *tcb = (task_tcb *)(node->owner_tcb);
+
+        // A. ʱﻮǴʱĵȴ˳ӵȴĶժ
+        list_remove(slot, node);
+        delay_timeout(tcb);
+
+        // B. ¼ӻؾλͼ
+        task_ready_insert(tcb);
+
+        // C. ռǰ񣬲Ҫл
+        if (task_can_preempt(tcb))
+        {
+            need_switch = 1;
+        }
+    }
+
+#if OS_TIMER_ENABLE
+    // ʱ (ҪѶʱĻԼᴥ)
+    os_timer_tick();
+#endif
+
+    // ʱƬֵ꣬ͬȼһ
+    if (os_time_slice_tick())
+    {
+        need_switch = 1;
+    }
+
+#if OS_BUDGET_ENABLE
+    // Ԥ㲹 / ǰԤù
+    if (os_budget_tick())
+    {
+        need_switch = 1;
+    }
+#endif
+
+    if (!need_switch)
+    {
+        // ʲôû䣬ǰܣʡһ PendSV (һı/ָ)
+        os_pendsv_avoided++;
+    }
+    else if (OSSchedLockNesting == 0)
+    {
+        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    }
+    else
+    {
+        // סˣȻʱƬˣҲֻţл
+        // ϵͳеǰ
+        // Լ OSSchedUnlock() 0ʱﲹл
+    }
+}
+
+// ============================================================
+// ѯһʱжٸ Tick  ( Tickless )
+// ÿֻҪͷڵ㣬Ҫж
+// ============================================================
+uint32_t os_delay_next_expiry(void)
+{
+    uint32_t min_ticks = OS_DELAY_NO_EXPIRY;
+    uint32_t remain;
+    int i;
+
+    for (i = 0; i < OS_TICK_WHEEL_SIZE; i++)
+    {
+        if (DelayWheel[i].head != NULL)
+        {
+            remain = DelayWheel[i].head->value - os_tick_count;
+            if (remain < min_ticks)
+            {
+                min_ticks = remain;
+            }
+        }
+    }
+    return min_ticks;
+}
+
+// ============================================================
+// Tickless 󲹳˯ Tick
+// ʱǾԵʱ䣬ֻҪ Tick ǰʣʱһˡ
+// ˯ʱᳬĵʱ䣬мĲﲻڣ
+// ڵǸ Tick  SysTick_Handler 
+// ============================================================
+void os_delay_step(uint32_t ticks)
+{
+    os_tick_count += ticks;
+}
@@ -0,0 +1,24 @@
+#ifndef __OS_DELAY_H
+#define __OS_DELAY_H
+
+#include <stdint.h>
+#include "task.h"
+
+// ûʱʱos_delay_next_expiry ֵ
+#define OS_DELAY_NO_EXPIRY  0xFFFFFFFFu
+
+// ʱ (ʱ䰴޷ŲֵȽϣܳȦ)
+#define OS_DELAY_MAX_TICKS  0x7FFFFFFFu
+
+extern volatile uint32_t os_pendsv_avoided;
+
+void os_delay_init(void);
+uint32_t os_get_tick(void);
+void os_tick_handler(void);
+void os_delay_to_tick(uint32_t wake_tick);
+void os_delay_arm(task_tcb *tcb, uint32_t timeout);
+void os_delay_cancel(task_tcb *tcb);
+uint32_t os_delay_next_expiry(void);
+void os_delay_step(uint32_t ticks);
+
+#endif
@@ -0,0 +1,108 @@
+#include "stm32f4xx.h"
+#include "task.h"
+#include "scheduler.h"
+#include "cpu_tick.h"
+#include "os_stats.h"
+
+// ϴμʱ DWT ڼ
+static uint32_t last_account_cycles;
+
+// ۼл (ֻʱ 1)
+volatile uint32_t os_switch_count = 0;
+
+// ϴβʱл ()
+static uint64_t window_start;
+static uint32_t window_switch_mark;
+
+// ============================================================
+//  DWT ڼ ( start_scheduler )
+// ============================================================
+void os_stats_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // ȴ򿪸ģ飬DWT 
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    last_account_cycles = DWT->CYCCNT;
+    window_start = cpu_now();
+    window_switch_mark = os_switch_count;
+}
+
+// ============================================================
+// ʱˣϴμ˵ڵӵǰͷ
+//  PendSV (лǰ)  SysTick ãεüԶС CYCCNT 
+// ============================================================
+void os_stats_account(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint32_t delta = now - last_account_cycles;
+
+    if (current_tcb != NULL)
+    {
+        current_tcb->run_cycles += delta;
+#if OS_BUDGET_ENABLE
+        os_budget_charge(current_tcb, delta); // ͬһҲǵ CPU Ԥ
+#endif
+    }
+    last_account_cycles = now;
+}
+
+// ============================================================
+// һͳƴ (ϴεõ)
+// usage: 飬д max_tasks summary: Ϣ
+// дúʼµĴ
+// ע⣺CPU ˯ʱ CYCCNT ͣԴڳ cpu_now() ƣ =  - 
+// ============================================================
+uint32_t os_cpu_usage_sample(task_usage_t *usage, uint32_t max_tasks, cpu_usage_t *summary)
+{
+    uint64_t now, window, busy = 0;
+    uint32_t n = 0;
+    task_tcb *tcb;
+
+    task_enter_critical();
+
+    os_stats_account(); // ȰѵǰһСҲ
+
+    now = cpu_now();
+    window = now - window_start;
+    if (window == 0) window = 1;
+
+    for (tcb = task_list_head; tcb != NULL; tcb = tcb->task_next)
+    {
+        uint64_t run = tcb->run_cycles - tcb->run_cycles_mark;
+        uint32_t switches = tcb->switch_count - tcb->switch_count_mark;
+
+        if (tcb != idle_tcb)
+        {
+            busy += run;
+        }
+
+        if (usage != NULL && n < max_tasks)
+        {
+            usage[n].tcb = tcb;
+            usage[n].task_name = tcb->task_name;
+            usage[n].cpu_usage = (run > window) ? 10000 : (uint32_t)(run * 10000 / window);
+            usage[n].switch_count = switches;
+            usage[n].budget_overruns = tcb->budget_overruns;
+            n++;
+        }
+
+        // ´ڴ￪ʼ
+        tcb->run_cycles_mark = tcb->run_cycles;
+        tcb->switch_count_mark = tcb->switch_count;
+    }
+
+    if (summary != NULL)
+    {
+        summary->window_cycles = window;
+        summary->idle_usage = (busy >= window) ? 0 : (uint32_t)((window - busy) * 10000 / window);
+        summary->switch_count = os_switch_count - window_switch_mark;
+        summary->task_count = n;
+    }
+
+    window_start = now;
+    window_switch_mark = os_switch_count;
+
+    task_exit_critical();
+    return n;
+}
@@ -0,0 +1,30 @@
+#ifndef __OS_STATS_H
+#define __OS_STATS_H
+
+#include <stdint.h>
+#include "task.h"
+
+// һڵͳ
+typedef struct
+{
+    task_tcb *tcb;
+    char *task_name;
+    uint32_t cpu_usage;      // CPU ռʣλ 0.01% (10000 = 100%)
+    uint32_t switch_count;   // ڱĴ
+    uint32_t budget_overruns;// CPU ԤۼƳ֧ (ûԤ 0)
+} task_usage_t;
+
+// ڵĻ
+typedef struct
+{
+    uint64_t window_cycles;  // ڳ (CPU )
+    uint32_t idle_usage;     // ռȣλ 0.01%
+    uint32_t switch_count;   // лܴ
+    uint32_t task_count;     // ʵд usage[] 
+} cpu_usage_t;
+
+void os_stats_init(void);
+void os_stats_account(void);
+uint32_t os_cpu_usage_sample(task_usage_t *usage, uint32_t max_tasks, cpu_usage_t *summary);
+
+#endif
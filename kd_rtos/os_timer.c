@@ -0,0 +1,418 @@
+#include "stm32f4xx.h"
+#include "task.h"
+#include "scheduler.h"
+#include "event.h"
+#include "os_delay.h"
+#include "os_timer.h"
+#include "mem_pool.h"
+
+#if OS_TIMER_ENABLE
+
+// ============================================================
+// ʱ
+// ʱһʱ֣ڵľ Tick ɢеڰʣʱ
+// ÿ Tick ֻǰ۵ͷڵ㣬ٸʱҲÿ Tick ɨ
+// ڵĻصܷ
+//   1. OS_TIMER_CTX_TICKֱ SysTick  (ӳСص̡)
+//   2. ĬϣҵصϣɶʱͳһִСͬһ Tick ڶٸʱ
+//      ֻѶʱһΣһѶĻصȫ
+// ʱ API õ os_isr_maskжﶼܵ
+// ============================================================
+
+#define TIMER_WHEEL_MASK  (OS_TIMER_WHEEL_SIZE - 1)
+
+// ʱʱ
+static list_t TimerWheel[OS_TIMER_WHEEL_SIZE];
+
+// ȶʱִеĻص (ȵڵִ)
+static os_timer_t *fire_head = NULL;
+static os_timer_t *fire_tail = NULL;
+
+// ƳִеĹ (os_defer_from_isr ύģύִ)
+static os_defer_t *defer_head = NULL;
+static os_defer_t *defer_tail = NULL;
+
+// ʱ
+static task_tcb *timer_tcb = NULL;
+
+// Ѷʱҵʱ (߸ж)
+static void timer_wheel_insert(os_timer_t *timer, uint32_t expire_tick)
+{
+    list_t *slot = &TimerWheel[expire_tick & TIMER_WHEEL_MASK];
+    uint32_t now = os_get_tick();
+    uint32_t remain = expire_tick - now;
+    list_node_t *pos = slot->head;
+    uint32_t i;
+
+    timer->node.value = expire_tick;
+
+    // ʣʱͬʱڵȹϵǰ
+    for (i = 0; i < slot->count; i++)
+    {
+        if (pos->value - now > remain) break;
+        pos = pos->next;
+    }
+
+    list_insert_before(slot, (i < slot->count) ? pos : NULL, &timer->node);
+}
+
+// ʱժ˳ѻûִеĻص (߸ж)
+static void timer_disarm(os_timer_t *timer)
+{
+    os_timer_t **pp;
+
+    if (timer->node.container != NULL)
+    {
+        list_remove(timer->node.container, &timer->node);
+    }
+
+    if (timer->fire_pending)
+    {
+        // صһֻм˳Ҿ
+        for (pp = &fire_head; *pp != NULL; pp = &(*pp)->fire_next)
+        {
+            if (*pp == timer)
+            {
+                *pp = timer->fire_next;
+                break;
+            }
+        }
+        if (fire_tail == timer)
+        {
+            // ɾǶβҵµĶβ
+            fire_tail = fire_head;
+            while (fire_tail != NULL && fire_tail->fire_next != NULL)
+            {
+                fire_tail = fire_tail->fire_next;
+            }
+        }
+        timer->fire_pending = 0;
+        timer->fire_next = NULL;
+    }
+}
+
+// ============================================================
+// ʱ˯֪ͨϣлصҪִоͱ
+// ============================================================
+static void timer_task(void)
+{
+    os_timer_t *timer;
+    os_timer_cb_t callback;
+    os_defer_t *work;
+    void (*fn)(void *arg);
+    void *arg;
+    uint32_t mask;
+
+    while (1)
+    {
+        (void)task_wait_notify();
+
+        // жƳٹĹ (һڵŻѱ)
+        while (1)
+        {
+            mask = os_isr_mask();
+            work = defer_head;
+            if (work != NULL)
+            {
+                defer_head = work->next;
+                if (defer_head == NULL) defer_tail = NULL;
+                work->next = NULL;
+                work->pending = 0;
+                fn = work->fn;
+                arg = work->arg;
+            }
+            os_isr_unmask(mask);
+
+            if (work == NULL) break;
+
+            fn(arg);
+        }
+
+        // һѶĻصȫ
+        while (1)
+        {
+            mask = os_isr_mask();
+            timer = fire_head;
+            if (timer != NULL)
+            {
+                fire_head = timer->fire_next;
+                if (fire_head == NULL) fire_tail = NULL;
+                timer->fire_next = NULL;
+                timer->fire_pending = 0;
+                callback = timer->callback;
+                arg = timer->arg;
+            }
+            os_isr_unmask(mask);
+
+            if (timer == NULL) break;
+
+            // صִ֮Уʱ
+            callback(timer, arg);
+        }
+    }
+}
+
+// ============================================================
+// ʼ ( os_init )ʱ֣ʱ
+// ============================================================
+void os_timer_init(void)
+{
+    int i;
+
+    for (i = 0; i < OS_TIMER_WHEEL_SIZE; i++)
+    {
+        list_init(&TimerWheel[i]);
+    }
+    fire_head = NULL;
+    fire_tail = NULL;
+    defer_head = NULL;
+    defer_tail = NULL;
+
+    timer_tcb = task_create((void *)timer_task, OS_TIMER_TASK_STACK_DEPTH, "timer", OS_TIMER_TASK_PRIORITY);
+}
+
+// ============================================================
+// 1. ʱ (ͣŵģҪ os_timer_start)
+// period:  (Tick)opt: OS_TIMER_ONE_SHOT / OS_TIMER_AUTO_RELOADٻ OS_TIMER_CTX_TICK
+// ============================================================
+os_timer_t* os_timer_create(char *name, uint32_t period, uint32_t opt, os_timer_cb_t callback, void *arg)
+{
+    os_timer_t *timer;
+
+    if (callback == NULL || period == 0 || period > OS_DELAY_MAX_TICKS) return NULL;
+
+    timer = (os_timer_t *)os_mem_alloc(sizeof(os_timer_t));
+    if (timer == NULL) return NULL;
+
+    timer->node.next = NULL;
+    timer->node.prev = NULL;
+    timer->node.owner_tcb = timer;
+    timer->node.container = NULL;
+    timer->node.value = 0;
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->period = period;
+    timer->opt = (uint8_t)opt;
+    timer->fire_pending = 0;
+    timer->fire_next = NULL;
+    timer->name = name;
+
+    return timer;
+}
+
+// ============================================================
+// 2. ɾʱ
+// ע⣺ҪڱɾһصִеĶʱ
+// ============================================================
+void os_timer_delete(os_timer_t *timer)
+{
+    uint32_t mask;
+
+    if (timer == NULL) return;
+
+    mask = os_isr_mask();
+    timer_disarm(timer);
+    os_isr_unmask(mask);
+
+    os_mem_free(timer);
+}
+
+// ============================================================
+// 3. ڿʼ period  Tick  (ѾܵĻʲô)
+// ============================================================
+int os_timer_start(os_timer_t *timer)
+{
+    uint32_t mask;
+
+    if (timer == NULL) return OS_ERR;
+
+    mask = os_isr_mask();
+    if (timer->node.container == NULL)
+    {
+        timer_wheel_insert(timer, os_get_tick() + timer->period);
+    }
+    os_isr_unmask(mask);
+
+    return OS_OK;
+}
+
+// ============================================================
+// 4. ֹͣ (ѾڡûüִеĻصҲһ𳷵)
+// ============================================================
+int os_timer_stop(os_timer_t *timer)
+{
+    uint32_t mask;
+
+    if (timer == NULL) return OS_ERR;
+
+    mask = os_isr_mask();
+    timer_disarm(timer);
+    os_isr_unmask(mask);
+
+    return OS_OK;
+}
+
+// ============================================================
+// 5. ãڲܣڿʼ¼ʱ (Źشʱ)
+// ============================================================
+int os_timer_reset(os_timer_t *timer)
+{
+    uint32_t mask;
+
+    if (timer == NULL) return OS_ERR;
+
+    mask = os_isr_mask();
+    if (timer->node.container != NULL)
+    {
+        list_remove(timer->node.container, &timer->node);
+    }
+    timer_wheel_insert(timer, os_get_tick() + timer->period);
+    os_isr_unmask(mask);
+
+    return OS_OK;
+}
+
+// ʱǲڼʱ (1=ܣ0=ͣ)
+uint32_t os_timer_is_active(os_timer_t *timer)
+{
+    if (timer == NULL) return 0;
+    return timer->node.container != NULL;
+}
+
+// ============================================================
+// ʱ Tick  ( os_tick_handler ã SysTick )
+// ============================================================
+void os_timer_tick(void)
+{
+    uint32_t now = os_get_tick();
+    list_t *slot = &TimerWheel[now & TIMER_WHEEL_MASK];
+    uint32_t wake = 0;
+    os_timer_t *timer;
+    uint32_t mask;
+
+    mask = os_isr_mask();
+
+    // ǰģڵĶʱһǰ
+    while (slot->head != NULL && slot->head->value == now)
+    {
+        timer = (os_timer_t *)(slot->head->owner_tcb);
+        list_remove(slot, &timer->node);
+
+        // ԶװεĵʱţΪصִʱƯ
+        if (timer->opt & OS_TIMER_AUTO_RELOAD)
+        {
+            timer_wheel_insert(timer, now + timer->period);
+        }
+
+        if (timer->opt & OS_TIMER_CTX_TICK)
+        {
+            // ֱ SysTick ִУصͣʱ (Լ)
+            os_isr_unmask(mask);
+            timer->callback(timer, timer->arg);
+            mask = os_isr_mask();
+        }
+        else if (!timer->fire_pending)
+        {
+            // ʱһεĻصûִͺϲһ
+            timer->fire_pending = 1;
+            timer->fire_next = NULL;
+            if (fire_tail != NULL) fire_tail->fire_next = timer;
+            else fire_head = timer;
+            fire_tail = timer;
+            wake = 1;
+        }
+    }
+
+    os_isr_unmask(mask);
+
+    //  Tick ܵ˶ٸʱֻһ
+    if (wake)
+    {
+        task_notify_from_isr(timer_tcb, 0);
+    }
+}
+
+// ============================================================
+// ƳִУжֻѹ (ʱ)Ļʱ
+// ============================================================
+void os_defer_init(os_defer_t *work, void (*fn)(void *arg), void *arg)
+{
+    work->fn = fn;
+    work->arg = arg;
+    work->next = NULL;
+    work->pending = 0;
+}
+
+// ύ (жϺﶼܵ)Ѿύ˻ûִеĻʲôҲ
+void os_defer_from_isr(os_defer_t *work)
+{
+    uint32_t mask = os_isr_mask();
+
+    if (work->pending)
+    {
+        os_isr_unmask(mask);
+        return;
+    }
+
+    work->pending = 1;
+    work->next = NULL;
+    if (defer_tail != NULL) defer_tail->next = work;
+    else defer_head = work;
+    defer_tail = work;
+
+    os_isr_unmask(mask);
+
+    task_notify_from_isr(timer_tcb, 0);
+}
+
+// ûִеĹ (ɾǰ)
+void os_defer_cancel(os_defer_t *work)
+{
+    os_defer_t **pp;
+    os_defer_t *prev = NULL;
+    uint32_t mask = os_isr_mask();
+
+    if (work->pending)
+    {
+        for (pp = &defer_head; *pp != NULL; prev = *pp, pp = &(*pp)->next)
+        {
+            if (*pp == work)
+            {
+                *pp = work->next;
+                if (defer_tail == work) defer_tail = prev;
+                break;
+            }
+        }
+        work->pending = 0;
+        work->next = NULL;
+    }
+
+    os_isr_unmask(mask);
+}
+
+// ============================================================
+// һʱжٸ Tick  ( Tickless ãҪж)
+// ûжʱܷ OS_DELAY_NO_EXPIRY
+// ============================================================
+uint32_t os_timer_next_expiry(void)
+{
+    uint32_t min_ticks = OS_DELAY_NO_EXPIRY;
+    uint32_t now = os_get_tick();
+    uint32_t remain;
+    int i;
+
+    for (i = 0; i < OS_TIMER_WHEEL_SIZE; i++)
+    {
+        if (TimerWheel[i].head != NULL)
+        {
+            remain = TimerWheel[i].head->value - now;
+            if (remain < min_ticks)
+            {
+                min_ticks = remain;
+            }
+        }
+    }
+    return min_ticks;
+}
+
+#endif
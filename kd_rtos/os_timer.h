@@ -0,0 +1,54 @@
+#ifndef __OS_TIMER_H
+#define __OS_TIMER_H
+
+#include <stdint.h>
+#include "list.h"
+#include "task.h"
+
+struct os_timer;
+
+// ʱص (timer ǵڵĶʱarg ǴʱĲ)
+typedef void (*os_timer_cb_t)(struct os_timer *timer, void *arg);
+
+// os_timer_create ѡ (Ի)
+#define OS_TIMER_ONE_SHOT       0x00 // һԣһξͣ
+#define OS_TIMER_AUTO_RELOAD    0x01 // Զװÿ period  Tick һ
+#define OS_TIMER_CTX_TICK       0x02 // صֱ SysTick  (Ҫ̣)Ĭڶʱ
+
+// ʱ
+typedef struct os_timer
+{
+    list_node_t node;           // ڶʱʱ (value = ڵľ Tickowner_tcb ָʱԼ)
+    os_timer_cb_t callback;     // ڻص
+    void *arg;                  // ص
+    uint32_t period;            //  (Tick)
+    uint8_t opt;                // OS_TIMER_AUTO_RELOAD / OS_TIMER_CTX_TICK
+    uint8_t fire_pending;       // ѾڣڶʱĻصﻹûִ
+    struct os_timer *fire_next; // صһ
+    char *name;
+} os_timer_t;
+
+// ƳٵʱִеĹ (жꡢֲж̫õĻ)
+// ǶҪĶظύִֻһ (ϲ)
+typedef struct os_defer
+{
+    void (*fn)(void *arg);      // ڶʱִ
+    void *arg;
+    struct os_defer *next;      // ִһ
+    uint8_t pending;            // Ѿύûִ
+} os_defer_t;
+
+void os_timer_init(void);
+os_timer_t* os_timer_create(char *name, uint32_t period, uint32_t opt, os_timer_cb_t callback, void *arg);
+void os_timer_delete(os_timer_t *timer);
+int os_timer_start(os_timer_t *timer);
+int os_timer_stop(os_timer_t *timer);
+int os_timer_reset(os_timer_t *timer);
+uint32_t os_timer_is_active(os_timer_t *timer);
+void os_timer_tick(void);
+uint32_t os_timer_next_expiry(void);
+void os_defer_init(os_defer_t *work, void (*fn)(void *arg), void *arg);
+void os_defer_from_isr(os_defer_t *work);
+void os_defer_cancel(os_defer_t *work);
+
+#endif
@@ -0,0 +1,148 @@
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "os_delay.h"
+#include "cpu_tick.h"
+
+// ============================================================
+// 
+// ÿھ Tick ߽ͷ (period_release += period)ΪִʱƯƣ
+// ˳ͳͷŶӦʱͽֹʱ·Ƶʲٽ߼
+// EDF  (edf.c) Ҳڲͳõͬһ period_* ֶ
+// ============================================================
+
+// һ Tick жٸ CPU  ( cpu_tick.c һ£1 Tick = 1ms)
+#define CYCLES_PER_TICK     (SystemCoreClock / 1000)
+#define CYCLES_PER_US       (SystemCoreClock / 1000000)
+
+// ӱͷʱ̵ڹ˶ٸ CPU  (߸ж)
+//  64 λ㣺32 λ 168MHz  25 ƻȥˣسʱɺܶ
+static uint64_t since_release(task_tcb *tcb)
+{
+    uint32_t ticks = os_get_tick() - tcb->period_release;
+    return (uint64_t)ticks * CYCLES_PER_TICK + cpu_tick_elapsed();
+}
+
+// ͳֵ 32 λ棬Ļⶥ (ⶥֵ΢Ҳ 25 ϣ㹻˵)
+static uint32_t clamp_cycles(uint64_t cycles)
+{
+    return (cycles > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32_t)cycles;
+}
+
+// ڵĻˣ¼Ӧʱ䣬жûдֹʱ (߸ж)
+// ͨ EDF 
+void period_job_done(task_tcb *tcb)
+{
+    uint64_t resp = since_release(tcb);
+
+    tcb->period_resp_last = clamp_cycles(resp);
+    tcb->period_resp_sum += resp;
+    if (tcb->period_resp_last > tcb->period_resp_max) tcb->period_resp_max = tcb->period_resp_last;
+    if (resp > (uint64_t)tcb->period_deadline * CYCLES_PER_TICK) tcb->period_miss++;
+    tcb->period_jobs++;
+}
+
+// µڿʼˣ¼ͷŶ = ͷʱ -> ʼ (߸ж)
+void period_job_started(task_tcb *tcb)
+{
+    tcb->period_jitter_last = clamp_cycles(since_release(tcb));
+    if (tcb->period_jitter_last > tcb->period_jitter_max)
+    {
+        tcb->period_jitter_max = tcb->period_jitter_last;
+    }
+}
+
+// ============================================================
+// 
+// period:    (Tick)
+// deadline: Խֹʱ (Tick) 0 ʾ
+// һڴӴʱʼÿһֻһ task_wait_period()
+// ============================================================
+task_tcb* task_create_periodic(void *task_function, uint32_t task_stack_depth, char *task_name,
+                               uint32_t task_priority, uint32_t period, uint32_t deadline)
+{
+    task_tcb *tcb;
+
+    if (period == 0 || period > OS_DELAY_MAX_TICKS) return NULL;
+    if (deadline == 0) deadline = period;
+
+    tcb = task_create(task_function, task_stack_depth, task_name, task_priority);
+    if (tcb == NULL) return NULL;
+
+    task_enter_critical();
+    tcb->period_ticks = period;
+    tcb->period_deadline = deadline;
+    tcb->period_release = os_get_tick();
+    task_exit_critical();
+
+    return tcb;
+}
+
+// ============================================================
+// ڵĻˣ¼Ӧʱ䣬˯һڵͷʱ
+// 󳬹һڵĻЩֱ (ֹʱ)
+// ============================================================
+void task_wait_period(void)
+{
+    task_tcb *tcb = current_tcb;
+    uint32_t behind;
+
+    // EDF  edf_wait_next_period
+    if (tcb == NULL || tcb->period_ticks == 0 || (tcb->task_options & TASK_OPT_EDF)) return;
+
+    task_enter_critical();
+
+    // 1. Ӧʱ = ͷʱ -> 
+    period_job_done(tcb);
+
+    // 2. ̫ࣺ
+    behind = os_get_tick() - tcb->period_release;
+    if (behind >= 2 * tcb->period_ticks)
+    {
+        uint32_t skip = behind / tcb->period_ticks - 1;
+        tcb->period_release += skip * tcb->period_ticks;
+        tcb->period_miss += skip;
+    }
+
+    task_exit_critical();
+
+    // 3. ˯һͷʱ (period_release ᱻƽһ)
+    os_delay_until(&tcb->period_release, tcb->period_ticks);
+
+    // 4. ˣ¼ͷŶ
+    task_enter_critical();
+    period_job_started(tcb);
+    task_exit_critical();
+}
+
+// ============================================================
+// ѯͳƣreset  0 ʱ˳ (¿ʼͳ)
+// ͨ EDF ܲ
+//  0 ɹ-1 
+// ============================================================
+int task_get_period_stats(task_tcb *tcb, period_stats_t *stats, uint32_t reset)
+{
+    if (tcb == NULL || tcb->period_ticks == 0 || stats == NULL) return -1;
+
+    task_enter_critical();
+
+    stats->jobs = tcb->period_jobs;
+    stats->deadline_miss = tcb->period_miss;
+    stats->jitter_last_us = tcb->period_jitter_last / CYCLES_PER_US;
+    stats->jitter_max_us = tcb->period_jitter_max / CYCLES_PER_US;
+    stats->response_last_us = tcb->period_resp_last / CYCLES_PER_US;
+    stats->response_max_us = tcb->period_resp_max / CYCLES_PER_US;
+    stats->response_avg_us = (tcb->period_jobs == 0) ? 0 :
+                             (uint32_t)(tcb->period_resp_sum / tcb->period_jobs / CYCLES_PER_US);
+
+    if (reset)
+    {
+        tcb->period_jobs = 0;
+        tcb->period_miss = 0;
+        tcb->period_jitter_max = 0;
+        tcb->period_resp_max = 0;
+        tcb->period_resp_sum = 0;
+    }
+
+    task_exit_critical();
+    return 0;
+}
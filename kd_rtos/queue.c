@@ -0,0 +1,244 @@
+#include <string.h>
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "event.h"
+#include "os_delay.h"
+#include "mem_pool.h"
+
+// ============================================================
+// ϢУλ + ȴ (Ϣ / ȿλ)
+// 䲻һ˲ǣͷҪôȿλҪôʧܣͻݲᶪ
+// ============================================================
+
+static int queue_send_common(queue_t *queue, const void *item, uint32_t timeout, uint32_t to_front);
+static int queue_recv_common(queue_t *queue, void *item, uint32_t timeout, uint32_t peek);
+
+// һϢ (֤߱пλٽ)ȻһϢ
+static void queue_put_locked(queue_t *queue, const void *item, uint32_t to_front)
+{
+    uint8_t *slot;
+
+    if (to_front)
+    {
+        // ӣָһдһľ
+        queue->head = (queue->head == 0) ? (queue->capacity - 1) : (queue->head - 1);
+        slot = queue->buf + queue->head * queue->item_size;
+    }
+    else
+    {
+        slot = queue->buf + queue->tail * queue->item_size;
+        if (++queue->tail == queue->capacity) queue->tail = 0;
+    }
+    memcpy(slot, item, queue->item_size);
+    queue->count++;
+
+    // ڵϢͻȼߵǸʸռŴ
+    wait_queue_wake_one(&queue->recv_wait);
+
+    //  select ĻȥǱߵǼһ
+    select_signal(&queue->select);
+}
+
+//  wq ˯һ (ٽʱҲٽ)
+// start/timeout 㻹ʣʱ䣺ԺֱˣҪŵʣµ
+//  OS_OK ʾ (ȥٲһ)ֱֵӷظû
+static int queue_block(wait_queue_t *wq, uint32_t start, uint32_t timeout)
+{
+    uint32_t remain = timeout;
+
+    if (timeout != OS_WAIT_FOREVER)
+    {
+        uint32_t passed = os_get_tick() - start;
+        remain = (passed < timeout) ? (timeout - passed) : 0;
+    }
+
+    if (remain == OS_NO_WAIT) return OS_ERR_TIMEOUT;
+
+    // ˣϽ
+    if (OSSchedLockNesting > 0) return OS_ERR;
+
+    // Ƴȴ (ʱĻͬʱʱ)
+    wait_queue_block(wq, remain);
+    task_exit_critical();
+
+    // ... ߣȶԷѣ߳ʱ ...
+
+    task_enter_critical();
+    return current_tcb->wait_result;
+}
+
+// ============================================================
+// 1. 
+// capacity: 漸Ϣitem_size: ÿϢֽ
+// ṹʹ洢һ (ܴС 32 λֱӾܾó˷뵽һСڴ)
+// ============================================================
+queue_t* queue_create(uint32_t capacity, uint32_t item_size)
+{
+    queue_t *queue;
+
+    if (capacity == 0 || item_size == 0) return NULL;
+    if (capacity > (UINT32_MAX - sizeof(queue_t)) / item_size) return NULL;
+
+    queue = (queue_t *)os_mem_alloc(sizeof(queue_t) + capacity * item_size);
+    if (queue == NULL) return NULL;
+
+    queue->type = EVENT_TYPE_QUEUE;
+    wait_queue_init(&queue->recv_wait);
+    wait_queue_init(&queue->send_wait);
+    queue->buf = (uint8_t *)(queue + 1);
+    queue->item_size = item_size;
+    queue->capacity = capacity;
+    queue->count = 0;
+    queue->head = 0;
+    queue->tail = 0;
+    select_link_init(&queue->select, queue);
+
+    return queue;
+}
+
+// ============================================================
+// 2. ɾ
+// ߵŵȫѣǷ OS_ERR_DELETED
+// ============================================================
+void queue_delete(queue_t *queue)
+{
+    if (queue == NULL) return;
+
+    task_enter_critical();
+    wait_queue_wake_all(&queue->recv_wait, OS_ERR_DELETED);
+    wait_queue_wake_all(&queue->send_wait, OS_ERR_DELETED);
+    select_detach(&queue->select);
+    os_mem_free(queue);
+    task_exit_critical();
+}
+
+// ============================================================
+// 3.  (һϢβ)
+// timeout: ʱȶٸ Tick (OS_NO_WAIT ȣOS_WAIT_FOREVER һֱ)
+//  OS_OK ȥˣOS_ERR_TIMEOUT ˵ȳʱOS_ERR_DELETED бɾˣOS_ERR /ס
+// ============================================================
+int queue_send(queue_t *queue, const void *item, uint32_t timeout)
+{
+    return queue_send_common(queue, item, timeout, 0);
+}
+
+// ӷͣͷһ queue_recv õ (Ϣ)
+int queue_send_to_front(queue_t *queue, const void *item, uint32_t timeout)
+{
+    return queue_send_common(queue, item, timeout, 1);
+}
+
+// жϰ棺ܵȣֱӷ OS_ERR_TIMEOUT
+// ѵҪж˳ (os_isr_exit) йȥ
+int queue_send_from_isr(queue_t *queue, const void *item)
+{
+    uint32_t mask;
+    int result = OS_ERR_TIMEOUT;
+
+    if (queue == NULL || item == NULL) return OS_ERR;
+
+    mask = os_isr_mask();
+    if (queue->count < queue->capacity)
+    {
+        queue_put_locked(queue, item, 0);
+        result = OS_OK;
+    }
+    os_isr_unmask(mask);
+
+    return result;
+}
+
+static int queue_send_common(queue_t *queue, const void *item, uint32_t timeout, uint32_t to_front)
+{
+    uint32_t start;
+    int result;
+
+    if (queue == NULL || item == NULL) return OS_ERR;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    // --- A: ˣȿλ ---
+    //  whileԺλֱķ
+    while (queue->count >= queue->capacity)
+    {
+        result = queue_block(&queue->send_wait, start, timeout);
+        if (result != OS_OK)
+        {
+            task_exit_critical();
+            return result;
+        }
+    }
+
+    // --- B: пλȥ ---
+    queue_put_locked(queue, item, to_front);
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// ============================================================
+// 4.  (ӶͷһϢӶ)
+//  OS_OK յˣOS_ERR_TIMEOUT յĵȳʱOS_ERR_DELETED бɾˣOS_ERR /ס
+// ============================================================
+int queue_recv(queue_t *queue, void *item, uint32_t timeout)
+{
+    return queue_recv_common(queue, item, timeout, 0);
+}
+
+// ͵ͷϢ (յĻһԵ)
+int queue_peek(queue_t *queue, void *item, uint32_t timeout)
+{
+    return queue_recv_common(queue, item, timeout, 1);
+}
+
+static int queue_recv_common(queue_t *queue, void *item, uint32_t timeout, uint32_t peek)
+{
+    uint32_t start;
+    int result;
+
+    if (queue == NULL || item == NULL) return OS_ERR;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    // --- A: յģϢ ---
+    while (queue->count == 0)
+    {
+        result = queue_block(&queue->recv_wait, start, timeout);
+        if (result != OS_OK)
+        {
+            task_exit_critical();
+            return result;
+        }
+    }
+
+    // --- B: Ϣ ---
+    memcpy(item, queue->buf + queue->head * queue->item_size, queue->item_size);
+
+    if (peek)
+    {
+        // Ϣڣǵһ¿ܱǸĽߵģȥ
+        wait_queue_wake_one(&queue->recv_wait);
+    }
+    else
+    {
+        if (++queue->head == queue->capacity) queue->head = 0;
+        queue->count--;
+
+        // ڳһλڵȿλͻȼߵǸ
+        wait_queue_wake_one(&queue->send_wait);
+    }
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// ============================================================
+// 5. ǰ˼Ϣ
+// ============================================================
+uint32_t queue_count(queue_t *queue)
+{
+    if (queue == NULL) return 0;
+    return queue->count;
+}
@@ -0,0 +1,267 @@
+#include <string.h>
+#include "stm32f4xx.h"
+#include "event.h"
+#include "ringbuf.h"
+
+// ============================================================
+// λ
+// ϲҪԭ
+//   1. head ֻ߸ģtail ֻ߸ģԸһ־ԭӵ
+//   2. ݺ±֮Ⱥ˳ DMB ֤дٷ headȶٹ黹 tail
+//   3. ռ LDREX/STREXм䱻ϹSTREX ʧ
+// Ψһжϵĵط "ӿձɷǿ" ʱһ֪ͨ (task_notify_from_isr)
+// ============================================================
+
+//  [old_head, new_head) ݣӿձɷǿվ֪ͨ
+static void ringbuf_publish(ringbuf_t *rb, uint32_t old_head, uint32_t new_head)
+{
+    rb->head = new_head;
+
+    // ֮ǰѾˣ˯
+    // (ûյĻһԼٿһ headý)
+    if (rb->notify_tcb != NULL && old_head == rb->tail && new_head != old_head)
+    {
+        task_notify_from_isr(rb->notify_tcb, rb->notify_value);
+    }
+}
+
+// ============================================================
+// ʼ (buf ɵṩsize  2 )
+//  OS_OK ɹOS_ERR 
+// ============================================================
+int ringbuf_init(ringbuf_t *rb, uint8_t *buf, uint32_t size)
+{
+    if (rb == NULL || buf == NULL || size < 2 || (size & (size - 1)) != 0) return OS_ERR;
+
+    rb->buf = buf;
+    rb->size = size;
+    rb->mask = size - 1;
+    rb->head = 0;
+    rb->tail = 0;
+    rb->reserve = 0;
+    rb->writers = 0;
+    rb->notify_tcb = NULL;
+    rb->notify_value = 0;
+
+    return OS_OK;
+}
+
+// ôӿձɷǿʱҪ֪ͨ (tcb Ϊ NULL ص֪ͨ)
+// ߵĵд
+//     while (1) {
+//         while ((n = ringbuf_read(&rb, buf, sizeof(buf))) != 0) handle(buf, n);
+//         task_wait_notify();
+//     }
+void ringbuf_set_notify(ringbuf_t *rb, task_tcb *tcb, uint32_t value)
+{
+    if (rb == NULL) return;
+    rb->notify_value = value;
+    rb->notify_tcb = tcb;
+}
+
+// Զֽ
+uint32_t ringbuf_count(ringbuf_t *rb)
+{
+    return rb->head - rb->tail;
+}
+
+// дֽ (÷ﲻѾԤûύĿռ)
+uint32_t ringbuf_free(ringbuf_t *rb)
+{
+    return rb->size - (rb->head - rb->tail);
+}
+
+// ============================================================
+// ߣд (ռ䲻ддµĲ)ʵдֽ
+// ============================================================
+uint32_t ringbuf_write(ringbuf_t *rb, const uint8_t *data, uint32_t len)
+{
+    uint32_t head = rb->head;
+    uint32_t space = rb->size - (head - rb->tail);
+    uint32_t off, n1;
+
+    if (len > space) len = space;
+    if (len == 0) return 0;
+
+    // дĩβƻؿͷĻο
+    off = head & rb->mask;
+    n1 = rb->size - off;
+    if (n1 > len) n1 = len;
+    memcpy(rb->buf + off, data, n1);
+    memcpy(rb->buf, data + n1, len - n1);
+
+    // 䵽ڴ棬߿µ head
+    __DMB();
+    ringbuf_publish(rb, head, head + len);
+
+    return len;
+}
+
+// ============================================================
+// ߣԭд (ʡһο DMA ֱ)
+// 㣬*len ĳ (д˷ NULL)
+// д ringbuf_write_commit ύʵд˶
+// ============================================================
+uint8_t* ringbuf_write_reserve(ringbuf_t *rb, uint32_t *len)
+{
+    uint32_t head = rb->head;
+    uint32_t space = rb->size - (head - rb->tail);
+    uint32_t off = head & rb->mask;
+    uint32_t n = rb->size - off;
+
+    if (n > space) n = space;
+    *len = n;
+
+    return (n != 0) ? (rb->buf + off) : NULL;
+}
+
+void ringbuf_write_commit(ringbuf_t *rb, uint32_t len)
+{
+    uint32_t head = rb->head;
+
+    if (len == 0) return;
+
+    __DMB();
+    ringbuf_publish(rb, head, head + len);
+}
+
+// ============================================================
+// ߣԤ len ֽ (ҪôȫҪô)
+//  OS_OK ɹ (ռ *span ƻؿͷĻ)OS_ERR ռ䲻
+// Ԥύ֮䲻Ҳе (ж֮ȻǶ׵)
+// ============================================================
+int ringbuf_mp_reserve(ringbuf_t *rb, uint32_t len, ringbuf_span_t *span)
+{
+    uint32_t r, w, off;
+
+    if (len == 0 || len > rb->size) return OS_ERR;
+
+    // 1. ǼԼдߣдύʱѴҵһ𷢲
+    do {
+        w = __LDREXW(&rb->writers);
+    } while (__STREXW(w + 1, &rb->writers) != 0);
+
+    // 2. ռ䣺 reserve ǰ len
+    do {
+        r = __LDREXW(&rb->reserve);
+        if (rb->size - (r - rb->tail) < len)
+        {
+            __CLREX();
+            ringbuf_mp_commit(rb); // עд (Ļ˳㷢Ѿдõ)
+            return OS_ERR;
+        }
+    } while (__STREXW(r + len, &rb->reserve) != 0);
+
+    off = r & rb->mask;
+    span->p1 = rb->buf + off;
+    span->n1 = rb->size - off;
+    if (span->n1 > len) span->n1 = len;
+    span->p2 = rb->buf;
+    span->n2 = len - span->n1;
+
+    return OS_OK;
+}
+
+// ============================================================
+// ߣύ (ÿԤɹҪӦһύ)
+// ϱ˵д (ڲ) ֻעԼд߰ѵĿǰΪֹߵĿռȫ
+// ΪжǶ׵ģڲһд
+// ============================================================
+void ringbuf_mp_commit(ringbuf_t *rb)
+{
+    uint32_t w, old_head, r;
+
+    // 䵽ڴ
+    __DMB();
+
+    do {
+        w = __LDREXW(&rb->writers);
+    } while (__STREXW(w - 1, &rb->writers) != 0);
+
+    // 滹дûд꣺
+    if (w != 1) return;
+
+    // 㣺 reserve reserve д head ֮дߵĻ STREX ʧܣ
+    // ضһͰҲˣд߻ûύ (writers Ϊ 0) 
+    do {
+        old_head = __LDREXW(&rb->head);
+        if (rb->writers != 0)
+        {
+            __CLREX();
+            return;
+        }
+        r = rb->reserve;
+    } while (__STREXW(r, &rb->head) != 0);
+
+    if (rb->notify_tcb != NULL && old_head == rb->tail && r != old_head)
+    {
+        task_notify_from_isr(rb->notify_tcb, rb->notify_value);
+    }
+}
+
+// ߣд (Ҫôȫдȥ OS_OKҪôһֽڶд OS_ERR)
+int ringbuf_mp_write(ringbuf_t *rb, const uint8_t *data, uint32_t len)
+{
+    ringbuf_span_t span;
+
+    if (ringbuf_mp_reserve(rb, len, &span) != OS_OK) return OS_ERR;
+
+    memcpy(span.p1, data, span.n1);
+    memcpy(span.p2, data + span.n1, span.n2);
+    ringbuf_mp_commit(rb);
+
+    return OS_OK;
+}
+
+// ============================================================
+// ߣ len ֽڣʵʶֽ
+// ============================================================
+uint32_t ringbuf_read(ringbuf_t *rb, uint8_t *data, uint32_t len)
+{
+    uint32_t tail = rb->tail;
+    uint32_t avail = rb->head - tail;
+    uint32_t off, n1;
+
+    if (len > avail) len = avail;
+    if (len == 0) return 0;
+
+    // ȿ headٶ
+    __DMB();
+
+    off = tail & rb->mask;
+    n1 = rb->size - off;
+    if (n1 > len) n1 = len;
+    memcpy(data, rb->buf + off, n1);
+    memcpy(data + n1, rb->buf, len - n1);
+
+    // ݶˣٰѿռ仹
+    __DMB();
+    rb->tail = tail + len;
+
+    return len;
+}
+
+// ============================================================
+// ߣԭض (ֱӽ DMA ߽)
+// ݵ㣬*len ĳ (յķ NULL)
+//  ringbuf_read_release 黹ʵõ˶
+// ============================================================
+uint8_t* ringbuf_read_peek(ringbuf_t *rb, uint32_t *len)
+{
+    uint32_t tail = rb->tail;
+    uint32_t avail = rb->head - tail;
+    uint32_t off = tail & rb->mask;
+    uint32_t n = rb->size - off;
+
+    if (n > avail) n = avail;
+    *len = n;
+
+    __DMB();
+    return (n != 0) ? (rb->buf + off) : NULL;
+}
+
+void ringbuf_read_release(ringbuf_t *rb, uint32_t len)
+{
+    __DMB();
+    rb->tail += len;
+}
@@ -0,0 +1,59 @@
+#ifndef __RINGBUF_H
+#define __RINGBUF_H
+
+#include <stdint.h>
+#include "task.h"
+
+// ============================================================
+// λ (ж -> ͨٽж)
+// ÷ͬһֻѡһ֣
+//    (SPSC)ringbuf_write / ringbuf_write_reserve + ringbuf_write_commit
+//                    ֻڴϣߺ߸ĸ±
+//    (MPSC)ringbuf_mp_write / ringbuf_mp_reserve + ringbuf_mp_commit
+//                    жϡһд LDREX/STREX ռ
+// ֻһringbuf_read / ringbuf_read_peek + ringbuf_read_release
+// ±һֱϼ ()õʱ & mask 2 
+// ============================================================
+typedef struct
+{
+    uint8_t *buf;
+    uint32_t size;              //  (ֽڣ2 )
+    uint32_t mask;              // size - 1
+    volatile uint32_t head;     // д±꣺ܿݵΪֹ
+    volatile uint32_t tail;     // ± (ֻ߸)
+    volatile uint32_t reserve;  // ߣѾߵĿռ䵽Ϊֹ
+    volatile uint32_t writers;  // ߣ˿ռ仹ûύĸ
+    task_tcb *notify_tcb;       // ӿձɷǿʱ֪ͨ (NULL ֪ͨ)
+    uint32_t notify_value;      // ֪ͨʱֵ
+} ringbuf_t;
+
+// ԤĿռ (ƵͷĻֳ)
+typedef struct
+{
+    uint8_t *p1;
+    uint32_t n1;
+    uint8_t *p2;
+    uint32_t n2;
+} ringbuf_span_t;
+
+int ringbuf_init(ringbuf_t *rb, uint8_t *buf, uint32_t size);
+void ringbuf_set_notify(ringbuf_t *rb, task_tcb *tcb, uint32_t value);
+uint32_t ringbuf_count(ringbuf_t *rb);
+uint32_t ringbuf_free(ringbuf_t *rb);
+
+// 
+uint32_t ringbuf_write(ringbuf_t *rb, const uint8_t *data, uint32_t len);
+uint8_t* ringbuf_write_reserve(ringbuf_t *rb, uint32_t *len);
+void ringbuf_write_commit(ringbuf_t *rb, uint32_t len);
+
+// 
+int ringbuf_mp_write(ringbuf_t *rb, const uint8_t *data, uint32_t len);
+int ringbuf_mp_reserve(ringbuf_t *rb, uint32_t len, ringbuf_span_t *span);
+void ringbuf_mp_commit(ringbuf_t *rb);
+
+// 
+uint32_t ringbuf_read(ringbuf_t *rb, uint8_t *data, uint32_t len);
+uint8_t* ringbuf_read_peek(ringbuf_t *rb, uint32_t *len);
+void ringbuf_read_release(ringbuf_t *rb, uint32_t len);
+
+#endif
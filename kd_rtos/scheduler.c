@@ -1,14 +1,17 @@
+#include <stddef.h>
 #include "task.h"
 #include "scheduler.h"
 #include "stm32f4xx.h" // Ϊʹ __CLZ
+#include "cpu_tick.h"
+#include "os_delay.h"
+#include "os_stats.h"
+#include "wait_queue.h"
+#include "os_timer.h"
 
 // ====================================================
 // ȫֱ
 // ====================================================
 
-// !!! ʱб !!!
-list_t DelayedList;
-
 //*Ƕ׼0=δ>0=
 //*volatile ֹŻ
 volatile uint8_t OSSchedLockNesting = 0;
@@ -16,20 +19,20 @@ volatile uint8_t OSSchedLockNesting = 0;
 // ֹл
 void OSSchedLock(void)
 {
-    __disable_irq(); //!жΪ˱ļӼԭӵ
+    task_enter_critical(); //!ٽΪ˱ļӼԭӵ
 
     if (OSSchedLockNesting < 255) // ֹ
     {
         OSSchedLockNesting++;
     }
 
-    __enable_irq();
+    task_exit_critical();
 }
 
 // 
 void OSSchedUnlock(void)
 {
-    __disable_irq();
+    task_enter_critical();
 
     if (OSSchedLockNesting > 0)
     {
@@ -46,19 +49,88 @@ void OSSchedUnlock(void)
         }
     }
 
-    __enable_irq();
+    task_exit_critical();
+}
+
+// ====================================================
+// жǶӳٵ
+// ÷ں˹ܵõж ( *_from_isr ں API ) βһ
+//     void DMA2_Stream0_IRQHandler(void)
+//     {
+//         os_isr_enter();
+//         sem_give_from_isr(rx_sem); sem_give_from_isr(tx_sem); ...
+//         os_isr_exit();
+//     }
+// ж﻽ֻһ "Ҫл" ı־ж˳ʱͳһһ PendSV
+// ====================================================
+
+volatile uint32_t os_isr_nesting = 0;       // жǶײ
+static volatile uint8_t os_yield_pending = 0; // жҪռ
+
+// ͳ (PendSV  / жϴ ÿжƽл)
+volatile uint32_t os_isr_exit_count = 0;    // ж˳
+volatile uint32_t os_isr_pendsv_count = 0;  // ж˳ʱ PendSV Ĵ
+volatile uint32_t os_yield_coalesced = 0;   // ϲл
+
+void os_isr_enter(void)
+{
+    // ȼжϴϵĻȼټʱֵ䣬ñ
+    os_isr_nesting++;
+}
+
+void os_isr_exit(void)
+{
+    uint32_t mask = os_isr_mask();
+
+    if (os_isr_nesting > 0) os_isr_nesting--;
+
+    if (os_isr_nesting == 0)
+    {
+        os_isr_exit_count++;
+
+        // ж˳лһԴ
+        if (os_yield_pending)
+        {
+            os_yield_pending = 0;
+            if (OSSchedLockNesting == 0)
+            {
+                SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+                os_isr_pendsv_count++;
+            }
+        }
+    }
+
+    os_isr_unmask(mask);
 }
 
-// б飺ReadyList[0] ȼ0ReadyList[31] ȼ31
+// б飺ReadyList[0] ȼ0ReadyList[MAX_PRIORITY-1] ȼ
 list_t ReadyList[MAX_PRIORITY];
 
-// ȼλͼĳλΪ1ʾȼ
-uint32_t PrioBitmap = 0;
+// !!! ȼλͼ !!!
+// PrioGroup  g λΪ1ʾ [g*32, g*32+31] һһȼ
+// PrioBitmap[g]  n λΪ1ʾȼ g*32+n 
+uint32_t PrioGroup = 0;
+uint32_t PrioBitmap[PRIO_GROUP_COUNT];
+
+// os_cpu.s  PendSV ̶ƫƶ⼸ṹ壬ֱ˱ͱȥͬĻࣺ
+// ReadyList[prio]  prio * 8 Ѱַhead  list_t ͷowner_tcb  list_node_t ƫ 8
+// stack_ptr  TCB ͷ
+typedef char os_cpu_list_size_check[(sizeof(list_t) == 8) ? 1 : -1];
+typedef char os_cpu_list_head_check[(offsetof(list_t, head) == 0) ? 1 : -1];
+typedef char os_cpu_owner_tcb_check[(offsetof(list_node_t, owner_tcb) == 8) ? 1 : -1];
+typedef char os_cpu_stack_ptr_check[(offsetof(task_tcb, stack_ptr) == 0) ? 1 : -1];
+
+// ÿȼĵȲԣӦλΪ1ʾ FIFOΪ0ʾʱƬת (Ĭ)
+static uint32_t PolicyFifoMap[PRIO_GROUP_COUNT];
 
 // ǰе
 task_tcb *current_tcb = NULL;
 // һҪе
 task_tcb *next_tcb = NULL;
+//  (ںԼУԶ)
+task_tcb *idle_tcb = NULL;
+// й (ûעᣬÿֵһ)
+static os_idle_hook_t idle_hook = NULL;
 
 // ====================================================
 // ڲλͼ
@@ -70,32 +142,196 @@ void bitmap_set(uint32_t prio)
     //!λ޷
     //!1 << 31 зĽ޷ (uint32_t) 
     //!ֻǵ 0x80000000ǳȫ
-    if (prio < MAX_PRIORITY) {
-        PrioBitmap |= (1u << prio);
-    }
-    else{
-    PrioBitmap |= (1u << (MAX_PRIORITY - 1));
+    if (prio >= MAX_PRIORITY) {
+        prio = MAX_PRIORITY - 1;
     }
+    PrioBitmap[prio >> 5] |= (1u << (prio & 31));
+    PrioGroup |= (1u << (prio >> 5));
 }
 
 // ĳȼ
 void bitmap_clear(uint32_t prio)
 {
     if (prio < MAX_PRIORITY) {
-        PrioBitmap &= ~(1u << prio);
+        PrioBitmap[prio >> 5] &= ~(1u << (prio & 31));
+        // 鶼ˣλҲҪ
+        if (PrioBitmap[prio >> 5] == 0)
+        {
+            PrioGroup &= ~(1u << (prio >> 5));
+        }
     }
 }
 
 // ȼ (ԽȼԽ)
-// ã31 ߣ0  ( bit λϰ)
+//  PrioGroup ߵ飬ߵλȼжټֻҪ CLZ
 uint32_t get_highest_priority(void)
 {
     // __CLZ ǰĸ
-    //  PrioBitmap = 0x80000000 (λ1)__CLZ  0   31 - 0 = 31
-    //  PrioBitmap = 0x00000001 (λ1)__CLZ  31  31 - 31 = 0
-    
-    if (PrioBitmap == 0) return 0; // û
-    return 31 - __CLZ(PrioBitmap);
+    //  PrioGroup = 0x80000000 (λ1)__CLZ  0   31 - 0 = 31
+    //  PrioGroup = 0x00000001 (λ1)__CLZ  31  31 - 31 = 0
+    uint32_t group;
+
+    if (PrioGroup == 0) return 0; // û
+    group = 31 - __CLZ(PrioGroup);
+    return (group << 5) + (31 - __CLZ(PrioBitmap[group]));
+}
+
+// ====================================================
+// б (߸ж)
+// ====================================================
+
+// ҵȼӦľбĩβǼλͼ
+void task_ready_insert(task_tcb *tcb)
+{
+#if OS_EDF_ENABLE
+    // EDF ƵﰴֹʱŶ (EDF ̳еȼʱͨŶӣ
+    // ̳ͨеһʱŵȴߵĽֹʱ䣬һֹʱ)
+    if (tcb->task_priority == OS_EDF_PRIORITY)
+    {
+        edf_ready_insert(tcb);
+        return;
+    }
+#endif
+    list_insert_end(&ReadyList[tcb->task_priority], &tcb->status_node);
+    bitmap_set(tcb->task_priority);
+}
+
+// Ӿбժ£ȼ˾λͼ
+void task_ready_remove(task_tcb *tcb)
+{
+    list_remove(&ReadyList[tcb->task_priority], &tcb->status_node);
+    if (ReadyList[tcb->task_priority].head == NULL)
+    {
+        bitmap_clear(tcb->task_priority);
+    }
+}
+
+// ǰʵռֵ (̳ȼܱõֵ)
+static uint32_t current_threshold(void)
+{
+    if (current_tcb->preempt_threshold > current_tcb->task_priority)
+    {
+        return current_tcb->preempt_threshold;
+    }
+    return current_tcb->task_priority;
+}
+
+// жϸվܲռǰ (ȼҪ߹ǰռֵ)
+uint32_t task_can_preempt(task_tcb *tcb)
+{
+#if OS_EDF_ENABLE
+    //  EDF ƵΣ˭Ľֹʱ˭
+    if (current_tcb != NULL && tcb->task_priority == OS_EDF_PRIORITY && current_tcb->task_priority == OS_EDF_PRIORITY)
+    {
+        return DEADLINE_BEFORE(tcb->edf_deadline, current_tcb->edf_deadline);
+    }
+#endif
+    return (current_tcb == NULL || tcb->task_priority > current_threshold());
+}
+
+// 񣺷ŻؾбֻռǰŴ
+//  IPC Ļ·
+void task_ready_wake(task_tcb *tcb)
+{
+    task_ready_insert(tcb);
+
+    if (OSSchedLockNesting == 0 && task_can_preempt(tcb))
+    {
+        if (os_isr_nesting > 0)
+        {
+            // жȼж˳
+            if (os_yield_pending) os_yield_coalesced++;
+            os_yield_pending = 1;
+        }
+        else
+        {
+            SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+        }
+    }
+}
+
+// ޸ʵȼ (ȼ̳)
+// ھбͻȼбO(1)
+//  IPC ȴͻȼͰ (񱻼̳ʱ˳Ҫű)
+// ʱбֵֻʱȻȼ
+void task_priority_set(task_tcb *tcb, uint32_t new_prio)
+{
+    if (new_prio >= MAX_PRIORITY) new_prio = MAX_PRIORITY - 1;
+    if (tcb->task_priority == new_prio) return;
+
+    if (tcb->status_node.container == &ReadyList[tcb->task_priority])
+    {
+        task_ready_remove(tcb);
+        tcb->task_priority = new_prio;
+        task_ready_insert(tcb);
+    }
+    else if (tcb->wait_queue != NULL)
+    {
+        wait_queue_requeue(tcb, new_prio);
+    }
+    else
+    {
+        tcb->task_priority = new_prio;
+    }
+}
+
+// ====================================================
+// ȲʱƬ
+// ====================================================
+
+// ĳȼĵȲԣSCHED_POLICY_RR (ʱƬת)  SCHED_POLICY_FIFO (ܣܵΪֹ)
+void os_set_priority_policy(uint32_t prio, uint32_t policy)
+{
+    if (prio >= MAX_PRIORITY) return;
+
+    task_enter_critical();
+    if (policy == SCHED_POLICY_FIFO)
+    {
+        PolicyFifoMap[prio >> 5] |= (1u << (prio & 31));
+    }
+    else
+    {
+        PolicyFifoMap[prio >> 5] &= ~(1u << (prio & 31));
+    }
+    task_exit_critical();
+}
+
+uint32_t os_get_priority_policy(uint32_t prio)
+{
+    if (prio >= MAX_PRIORITY) return SCHED_POLICY_RR;
+    return (PolicyFifoMap[prio >> 5] & (1u << (prio & 31))) ? SCHED_POLICY_FIFO : SCHED_POLICY_RR;
+}
+
+// ʱƬ ( os_tick_handler ÿ Tick )
+//  1 ʾǰʱƬ꣬ѾѶͷøͬȼһҪл
+uint32_t os_time_slice_tick(void)
+{
+    task_tcb *tcb = current_tcb;
+    list_t *list;
+
+    if (tcb == NULL) return 0;
+    list = &ReadyList[tcb->task_priority];
+
+    // ԼѾˡȼ FIFOռֵת
+    if (tcb->status_node.container != list) return 0;
+    if (PolicyFifoMap[tcb->task_priority >> 5] & (1u << (tcb->task_priority & 31))) return 0;
+    if (tcb->preempt_threshold > tcb->task_priority) return 0;
+
+    if (tcb->slice_remaining > 1)
+    {
+        tcb->slice_remaining--;
+        return 0;
+    }
+
+    // ʱƬ꣺װһ
+    tcb->slice_remaining = (tcb->time_slice != 0) ? tcb->time_slice : OS_TIME_SLICE_TICKS;
+
+    // ͬȼֻԼ ()
+    if (list->count < 2 || list->head != &tcb->status_node) return 0;
+
+    // !!! ʱƬת (Round-Robin) !!!Ѷͷøһ
+    list->head = tcb->status_node.next;
+    return 1;
 }
 
 // !!! ʼ ( main  os_start ֮ǰ) !!!
@@ -108,12 +344,41 @@ void os_init(void)
     {
         list_init(&ReadyList[i]);
     }
-    // ʼʱб
-    list_init(&DelayedList);
+    // λͼȼĬʱƬת
+    PrioGroup = 0;
+    for(i=0; i<PRIO_GROUP_COUNT; i++)
+    {
+        PrioBitmap[i] = 0;
+        PolicyFifoMap[i] = 0;
+    }
+#if OS_EDF_ENABLE
+    // EDF һתͷ (ֹʱ) һֱܵΪֹ
+    PolicyFifoMap[OS_EDF_PRIORITY >> 5] |= (1u << (OS_EDF_PRIORITY & 31));
+#endif
+    // ʼʱʱ
+    os_delay_init();
+#if OS_TIMER_ENABLE
+    // ʼʱ (˳㴴ʱ)
+    os_timer_init();
+#endif
+}
+
+// ====================================================
+// PendSV һȵвжҪ
+// ====================================================
+void os_switch_account(void)
+{
+    // ʱ (Ѹղʱǵǰͷ)
+    os_stats_account();
+
+#if OS_BUDGET_ENABLE
+    // ԤùĵǰȽ/PendSV ȥһ
+    os_budget_enforce();
+#endif
 }
 
 // ====================================================
-// ģ㷨
+// ģ㷨 (PendSV ·os_switch_account Ѿ)
 // ====================================================
 void switch_context_logic(void)
 {
@@ -123,22 +388,137 @@ void switch_context_logic(void)
     // 2. ȡȼб
     list_t *target_list = &ReadyList[highest_prio];
     list_node_t *node = target_list->head;
-    
-    if (node != NULL)
+
+    // !!! ռֵ !!!
+    // ǰھ (Լ)ֵû˳ֵ
+    // (ֵҲͬȼʱƬת)
+    if (current_tcb != NULL &&
+        current_tcb->preempt_threshold > current_tcb->task_priority &&
+        current_tcb->status_node.container == &ReadyList[current_tcb->task_priority] &&
+        highest_prio <= current_threshold())
     {
-        // ҵȼ
+        next_tcb = current_tcb;
+    }
+    else if (node != NULL)
+    {
+        // ҵȼ (ͷ)
+        // ʱƬת os_time_slice_tick ﲻÿлתһ
         next_tcb = (task_tcb *)(node->owner_tcb);
-        // !!! ޸ģʵʱƬת (Round-Robin) !!!
-        target_list->head = node->next;
     }
     else
     {
         // !!! 쳣 !!!
-        // пԲ
-        // û봦 next_tcb ݡ
-        
-        // ʱûܣõǰܣָָֹ
-        // ʽ Idle Task 
+        // ԶԲ
+        // ֻ start_scheduler ֮ǰףֹ next_tcb ݡ
         next_tcb = current_tcb;
     }
+
+    // 3. ͳл (ͬһܲ)
+    if (next_tcb != current_tcb)
+    {
+        next_tcb->switch_count++;
+        os_switch_count++;
+    }
+}
+
+// ====================================================
+// 
+// ====================================================
+
+// ʱ˯ (Tickless ͨ WFI)
+// ע⣺õ PRIMASK (__disable_irq)  BASEPRI
+// Ϊ BASEPRI εжϽв WFIжڼ CPU ˯
+// ȼжܰѣֻҪ SysTick ָŽ ISR
+static void idle_sleep(void)
+{
+    __disable_irq();
+
+    // ȷֻʣԼ (жǰܸжϻ˱)
+    // ס˻ PendSV Ѿ˵ҪлҲ˯
+    if (get_highest_priority() == IDLE_TASK_PRIORITY &&
+        ReadyList[IDLE_TASK_PRIORITY].count == 1 &&
+        OSSchedLockNesting == 0 &&
+        (SCB->ICSR & SCB_ICSR_PENDSVSET_Msk) == 0)
+    {
+#if OS_TICKLESS_ENABLE
+        uint32_t expected_ticks = os_delay_next_expiry();
+#if OS_BUDGET_ENABLE
+        // Ԥ㲹Ҳðʱ
+        uint32_t budget_ticks = os_budget_next_expiry();
+        if (budget_ticks < expected_ticks) expected_ticks = budget_ticks;
+#endif
+#if OS_TIMER_ENABLE
+        // ʱҲðʱ
+        uint32_t timer_ticks = os_timer_next_expiry();
+        if (timer_ticks < expected_ticks) expected_ticks = timer_ticks;
+#endif
+        if (expected_ticks >= OS_TICKLESS_MIN_TICKS)
+        {
+            // һԲʱ
+            uint32_t slept = cpu_tick_sleep(expected_ticks);
+            if (slept > 0)
+            {
+                os_delay_step(slept);
+            }
+        }
+        else
+#endif
+        {
+            // һ Tick £ͨ WFI 
+            __DSB();
+            __WFI();
+            __ISB();
+        }
+    }
+
+    __enable_irq(); // жϺ󣬻ǵǸжϲŻִ
+}
+
+// עй (ڹκλĺ)
+void os_register_idle_hook(os_idle_hook_t hook)
+{
+    idle_hook = hook;
+}
+
+static void idle_task(void)
+{
+    while (1)
+    {
+        if (idle_hook)
+            idle_hook();
+
+        idle_sleep();
+    }
+}
+
+// ====================================================
+//  ( main  os_initû֮ã᷵)
+// ====================================================
+void start_scheduler(void)
+{
+    // 1.  (ȼ֤ ReadyList ԶΪ)
+    idle_tcb = task_create((void *)idle_task, IDLE_TASK_STACK_DEPTH, "idle", IDLE_TASK_PRIORITY);
+
+    // ʱ򱣻PSP û׼֮ǰ PendSV
+    __disable_irq();
+
+    // 2. ѡһҪе
+    switch_context_logic();
+    current_tcb = next_tcb;
+
+    // 3. жȼȫռȼ (ûȼ)PendSV  SysTick ŵͣ
+    //    Ƕ OS_MAX_SYSCALL_PRIORITY ֮£ᱻںٽס
+    NVIC_PriorityGroupConfig(NVIC_PriorityGroup_4);
+    NVIC_SetPriority(PendSV_IRQn, (1u << __NVIC_PRIO_BITS) - 1);
+    NVIC_SetPriority(SysTick_IRQn, (1u << __NVIC_PRIO_BITS) - 1);
+
+#if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
+    // ѹջ쳣ʱֻԤ֡λãõ FPU длԿ
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+#endif
+
+    // 4.  DWT ڼ (CPU ռͳ) SysTickһ
+    os_stats_init();
+    cpu_tick_init();
+    os_start();
 }
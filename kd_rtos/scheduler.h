@@ -4,17 +4,57 @@
 #include "list.h"
 #include "task.h"
 
+// λͼ (ÿ 32 ȼ)
+#define PRIO_GROUP_COUNT  ((MAX_PRIORITY + 31) / 32)
+
 extern list_t ReadyList[MAX_PRIORITY];
-extern list_t DelayedList;
+extern uint32_t PrioGroup;
+extern uint32_t PrioBitmap[PRIO_GROUP_COUNT];
 extern task_tcb *current_tcb;
+extern task_tcb *idle_tcb;
 extern volatile uint8_t OSSchedLockNesting;
+extern volatile uint32_t os_switch_count;
+extern volatile uint32_t os_isr_nesting;
+extern volatile uint32_t os_isr_exit_count;
+extern volatile uint32_t os_isr_pendsv_count;
+extern volatile uint32_t os_yield_coalesced;
+
+typedef void (*os_idle_hook_t)(void);
+
+// EDF ʱ䰴޷ŲֵȽ (Tick Ҳû)
+#define DEADLINE_BEFORE(a, b)   ((int32_t)((a) - (b)) < 0)
+
+// ÿȼĵȲ
+#define SCHED_POLICY_RR     0   // ʱƬת (Ĭ)
+#define SCHED_POLICY_FIFO   1   // ܣͬȼ֮䲻ת
 
 void bitmap_set(uint32_t prio);
 void bitmap_clear(uint32_t prio);
 uint32_t get_highest_priority(void);
+void task_ready_insert(task_tcb *tcb);
+void edf_ready_insert(task_tcb *tcb);
+void edf_set_deadline(task_tcb *tcb, uint32_t deadline);
+void task_ready_remove(task_tcb *tcb);
+void task_ready_wake(task_tcb *tcb);
+uint32_t task_can_preempt(task_tcb *tcb);
+void task_priority_set(task_tcb *tcb, uint32_t new_prio);
+void os_switch_account(void);
 void switch_context_logic(void);
+void os_isr_enter(void);
+void os_isr_exit(void);
 void OSSchedLock(void);
 void OSSchedUnlock(void);
 void os_init(void);
+void os_start(void); // os_cpu.s
+void os_register_idle_hook(os_idle_hook_t hook);
+void os_set_priority_policy(uint32_t prio, uint32_t policy);
+uint32_t os_get_priority_policy(uint32_t prio);
+uint32_t os_time_slice_tick(void);
+void os_budget_charge(task_tcb *tcb, uint32_t cycles);
+uint32_t os_budget_enforce(void);
+uint32_t os_budget_tick(void);
+uint32_t os_budget_next_expiry(void);
+void period_job_done(task_tcb *tcb);
+void period_job_started(task_tcb *tcb);
 
 #endif
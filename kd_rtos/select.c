@@ -0,0 +1,260 @@
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "event.h"
+#include "os_delay.h"
+#include "mem_pool.h"
+
+// ============================================================
+// select ϣһͬʱȺü (ź䡢С/Ϣ)
+// ÷
+//     select_add(set, rx_queue); select_add(set, cmd_sem); ...
+//     while (1) {
+//         void *obj = select_wait(set, 100);
+//         if (obj == rx_queue) queue_recv(rx_queue, &msg, OS_NO_WAIT);
+//         else if (obj == cmd_sem) sem_take_timeout(cmd_sem, OS_NO_WAIT);
+//     }
+// ԱһݾͰԼҵϵľб (ѾžͲ)O(1)
+// select_wait Ӿбȡȡʱȷһ (Ѿÿ)
+// ============================================================
+
+//  ->  select  (ֵ֧ͷ NULL)
+static select_link_t* select_link_of(void *obj)
+{
+    switch (*(event_type_t *)obj)
+    {
+    case EVENT_TYPE_SEM:     return &((sem_t *)obj)->select;
+    case EVENT_TYPE_MBOX:    return &((mailbox_t *)obj)->select;
+    case EVENT_TYPE_QUEUE:   return &((queue_t *)obj)->select;
+    case EVENT_TYPE_STREAM:
+    case EVENT_TYPE_MSG_BUF: return &((stream_buf_t *)obj)->select;
+    default:                 return NULL;
+    }
+}
+
+// ǲ (߸ٽ)
+static uint32_t select_obj_ready(void *obj)
+{
+    stream_buf_t *sb;
+
+    switch (*(event_type_t *)obj)
+    {
+    case EVENT_TYPE_SEM:   return ((sem_t *)obj)->counter > 0;
+    case EVENT_TYPE_MBOX:  return ((mailbox_t *)obj)->is_full;
+    case EVENT_TYPE_QUEUE: return ((queue_t *)obj)->count > 0;
+    case EVENT_TYPE_STREAM:
+    case EVENT_TYPE_MSG_BUF:
+        sb = (stream_buf_t *)obj;
+        return (sb->a_end - sb->a_start) + (sb->b_active ? sb->b_end : 0) >= sb->trigger_level;
+    default:
+        return 0;
+    }
+}
+
+// ============================================================
+// ںڲһĹ (߸ٽ)
+// ============================================================
+
+// 󴴽ʱʼ
+void select_link_init(select_link_t *link, void *obj)
+{
+    link->set = NULL;
+    link->member_node.next = NULL;
+    link->member_node.prev = NULL;
+    link->member_node.owner_tcb = obj;
+    link->member_node.container = NULL;
+    link->ready_node.next = NULL;
+    link->ready_node.prev = NULL;
+    link->ready_node.owner_tcb = obj;
+    link->ready_node.container = NULL;
+}
+
+// ˣҵϵľбϣѵȼϵ
+void select_signal(select_link_t *link)
+{
+    select_set_t *set = link->set;
+
+    if (set == NULL) return;
+
+    if (link->ready_node.container == NULL)
+    {
+        list_insert_end(&set->ready_list, &link->ready_node);
+    }
+    wait_queue_wake_one(&set->wait_queue);
+}
+
+// Ҫɾ (߱Ƴ)Ӽժɾ
+void select_detach(select_link_t *link)
+{
+    select_set_t *set = link->set;
+
+    if (set == NULL) return;
+
+    if (link->ready_node.container != NULL)
+    {
+        list_remove(&set->ready_list, &link->ready_node);
+    }
+    list_remove(&set->members, &link->member_node);
+    link->set = NULL;
+}
+
+// ڼ˯һ (ٽʱҲٽ)
+//  OS_OK ʾ (ȥٲһ)ֱֵӷظû
+static int select_block(wait_queue_t *wq, uint32_t start, uint32_t timeout)
+{
+    uint32_t remain = timeout;
+
+    if (timeout != OS_WAIT_FOREVER)
+    {
+        uint32_t passed = os_get_tick() - start;
+        remain = (passed < timeout) ? (timeout - passed) : 0;
+    }
+
+    if (remain == OS_NO_WAIT) return OS_ERR_TIMEOUT;
+
+    // ˣϽ
+    if (OSSchedLockNesting > 0) return OS_ERR;
+
+    wait_queue_block(wq, remain);
+    task_exit_critical();
+
+    // ... ߣĳԱݣ߳ʱ ...
+
+    task_enter_critical();
+    return current_tcb->wait_result;
+}
+
+// ============================================================
+// 1. 
+// ============================================================
+select_set_t* select_set_create(void)
+{
+    select_set_t *set = (select_set_t *)os_mem_alloc(sizeof(select_set_t));
+    if (set == NULL) return NULL;
+
+    set->type = EVENT_TYPE_SELECT;
+    wait_queue_init(&set->wait_queue);
+    list_init(&set->members);
+    list_init(&set->ready_list);
+
+    return set;
+}
+
+// ============================================================
+// 2. ɾ (Աɾֻժڵȵ񷵻 NULL)
+// ============================================================
+void select_set_delete(select_set_t *set)
+{
+    if (set == NULL) return;
+
+    task_enter_critical();
+
+    while (set->members.head != NULL)
+    {
+        select_detach(select_link_of(set->members.head->owner_tcb));
+    }
+    wait_queue_wake_all(&set->wait_queue, OS_ERR_DELETED);
+    os_mem_free(set);
+
+    task_exit_critical();
+}
+
+// ============================================================
+// 3. Ѷӽ (һֻһ)
+//  OS_OK ɹOS_ERR Ͳֻ֧Ѿڱļ
+// ============================================================
+int select_add(select_set_t *set, void *obj)
+{
+    select_link_t *link;
+
+    if (set == NULL || obj == NULL) return OS_ERR;
+
+    link = select_link_of(obj);
+    if (link == NULL) return OS_ERR;
+
+    task_enter_critical();
+
+    if (link->set != NULL)
+    {
+        task_exit_critical();
+        return OS_ERR;
+    }
+
+    link->set = set;
+    list_insert_end(&set->members, &link->member_node);
+
+    // ӽʱݣϵǼ
+    if (select_obj_ready(obj))
+    {
+        select_signal(link);
+    }
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// ============================================================
+// 4. ѶƳ
+// ============================================================
+int select_remove(select_set_t *set, void *obj)
+{
+    select_link_t *link;
+
+    if (set == NULL || obj == NULL) return OS_ERR;
+
+    link = select_link_of(obj);
+    if (link == NULL) return OS_ERR;
+
+    task_enter_critical();
+
+    if (link->set != set)
+    {
+        task_exit_critical();
+        return OS_ERR;
+    }
+    select_detach(link);
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// ============================================================
+// 5. ȼһ
+// ݵǸ (ҪԼĽӿڣ OS_NO_WAIT)
+// ʱϱɾס NULL
+// ============================================================
+void* select_wait(select_set_t *set, uint32_t timeout)
+{
+    list_node_t *node;
+    uint32_t start;
+    void *obj;
+
+    if (set == NULL) return NULL;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    while (1)
+    {
+        while ((node = set->ready_list.head) != NULL)
+        {
+            obj = node->owner_tcb;
+            if (select_obj_ready(obj))
+            {
+                // ھб (ֹܲһ)תβ
+                // ´ȿĳԱһæĳԱ
+                set->ready_list.head = node->next;
+                task_exit_critical();
+                return obj;
+            }
+
+            // Ѿÿˣժ´Ǽ
+            list_remove(&set->ready_list, node);
+        }
+
+        if (select_block(&set->wait_queue, start, timeout) != OS_OK)
+        {
+            task_exit_critical();
+            return NULL;
+        }
+    }
+}
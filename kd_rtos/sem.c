@@ -1,13 +1,59 @@
 #include "stm32f4xx.h"
-#include <stdlib.h>
 #include "event.h"
 #include "scheduler.h"
+#include "mem_pool.h"
+
+static void sem_give_locked(sem_t *sem);
+
+#if OS_SEM_FAST_PATH_ENABLE
+// ============================================================
+// ޾· (LDREX/STREXٽ)
+// ԭLDREX  STREX ֻ֮Ҫ쳣 (жϡPendSV)CPU ռǣ
+// STREX ͻʧܣ¶һС㹻 " + ޸" ԭӵ
+// ============================================================
+
+// ԴֱӼ 1 1ûԴ 0 (ȥ·˯)
+static __inline uint32_t sem_take_fast(sem_t *sem)
+{
+    uint32_t count;
+
+    do {
+        count = __LDREXW(&sem->counter);
+        if (count == 0)
+        {
+            __CLREX();
+            return 0;
+        }
+    } while (__STREXW(count - 1, &sem->counter) != 0);
+
+    return 1;
+}
+
+// ûڵȾֱӼ 1 1ڵȷ 0 (ȥ·)
+//  select Ҳ· (ҪȥǱߵǼ)
+// ȴбֻٽģĵһһǣSTREX ʧ
+static __inline uint32_t sem_give_fast(sem_t *sem)
+{
+    uint32_t count;
+
+    do {
+        count = __LDREXW(&sem->counter);
+        if (sem->wait_queue.count != 0 || sem->select.set != NULL)
+        {
+            __CLREX();
+            return 0;
+        }
+    } while (__STREXW(count + 1, &sem->counter) != 0);
+
+    return 1;
+}
+#endif
 
 // ̬ź
 sem_t* sem_create(uint32_t init_count)
 {
     // 1. Ӷڴ
-    sem_t *sem = (sem_t *)malloc(sizeof(sem_t));
+    sem_t *sem = (sem_t *)os_mem_alloc(sizeof(sem_t));
     
     // 2. Ƿɹ
     if (sem == NULL)
@@ -18,7 +64,8 @@ sem_t* sem_create(uint32_t init_count)
     // 3. ʼԱ (֮ǰ sem_init ߼һ)
     sem->type = EVENT_TYPE_SEM;
     sem->counter = init_count;
-    list_init(&sem->wait_list); // ʼȴ
+    wait_queue_init(&sem->wait_queue); // ʼȴ
+    select_link_init(&sem->select, sem);
 
     // 4. ָ
     return sem;
@@ -29,78 +76,77 @@ void sem_delete(sem_t *sem)
 {
     if (sem == NULL) return;
 
-    // 1. ж ()
-    __disable_irq();
-
-    // 2. [峡ж] ڵȴź
-    // ֻҪͷΪգ˵Ŷ
-    while (sem->wait_list.head != NULL)
-    {
-        // ȡһù
-        list_node_t *node = sem->wait_list.head;
-        task_tcb *tcb = (task_tcb *)(node->owner_tcb);
-
-        // A. źĵȴбƳ
-        list_remove(&sem->wait_list, node);
+    // 1. ٽ ()
+    task_enter_critical();
 
-        // B. ǿؾб (ɹ»Ұ)
-        list_insert_end(&ReadyList[tcb->task_priority], node);
-
-        // C. ָλͼ
-        bitmap_set(tcb->task_priority);
-
-        // (ʵӦһ tcb->error_code = ERR_DELETED)
-        // Ŀǰָֻ
-    }
+    // 2. [峡ж] ڵȴź (ǿؾбɹ»Ұ)
+    // ǵ sem_take_timeout ᷵ OS_ERR_DELETED
+    wait_queue_wake_all(&sem->wait_queue, OS_ERR_DELETED);
+    select_detach(&sem->select);
 
     // 3.ȫͷڴ
-    free(sem);
-
-    // 4.  (иȼǿƻ)
-    if (OSSchedLockNesting == 0)
-    {
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-    }
+    // (ѵռĻwait_queue_wake_all Ѿ˵)
+    os_mem_free(sem);
 
-    __enable_irq();
+    task_exit_critical();
 }
 
 // ============================================================
 // sem_take (ԭ sem_wait)
-// 壺ͼ""һԴò˯
+// 壺ͼ""һԴò˯ (һֱ)
 // ============================================================
 void sem_take(sem_t *sem)
 {
-    // ˣϽ
-    if (OSSchedLockNesting > 0) return;
+    (void)sem_take_timeout(sem, OS_WAIT_FOREVER);
+}
+
+// ============================================================
+// ʱ sem_take
+// timeout: ȶٸ Tick (OS_NO_WAIT ȣOS_WAIT_FOREVER һֱ)
+//  OS_OK õˣOS_ERR_TIMEOUT ʱOS_ERR_DELETED źɾˣ
+// OS_ERR ߵס˲
+// ============================================================
+int sem_take_timeout(sem_t *sem, uint32_t timeout)
+{
+    if (sem == NULL) return OS_ERR;
+
+#if OS_SEM_FAST_PATH_ENABLE
+    // Դٽֱ
+    if (sem_take_fast(sem)) return OS_OK;
+#endif
 
-    __disable_irq();
+    task_enter_critical();
 
     // --- AԴֱ ---
     if (sem->counter > 0)
     {
         sem->counter--;
+        task_exit_critical();
+        return OS_OK;
     }
-    // --- BûԴȥ˯ ---
-    else
+
+    // --- BûԴ ---
+    if (timeout == OS_NO_WAIT)
     {
-        // 1. ӾбƳ
-        list_remove(&ReadyList[current_tcb->task_priority], &current_tcb->status_node);
+        task_exit_critical();
+        return OS_ERR_TIMEOUT;
+    }
 
-        // 2. λͼ
-        if (ReadyList[current_tcb->task_priority].head == NULL)
-        {
-            bitmap_clear(current_tcb->task_priority);
-        }
+    // ˣϽ
+    if (OSSchedLockNesting > 0)
+    {
+        task_exit_critical();
+        return OS_ERR;
+    }
 
-        // 3. źȴб
-        list_insert_end(&sem->wait_list, &current_tcb->status_node);
+    // --- Cȥ˯ ---
+    // ӾбƳȼźĵȴ (ʱĻͬʱʱ)
+    wait_queue_block(&sem->wait_queue, timeout);
+    task_exit_critical();
 
-        // 4. 
-        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-    }
+    // ... ߣsem_give ֱӰԴǣ߳ʱ ...
 
-    __enable_irq();
+    return current_tcb->wait_result;
 }
 
 // ============================================================
@@ -109,52 +155,58 @@ void sem_take(sem_t *sem)
 // ============================================================
 void sem_give(sem_t *sem)
 {
-    __disable_irq();
-
-    // --- AŶӣֱӸ () ---
-    if (sem->wait_list.head != NULL)
-    {
-        // 1. ȡŶӵ
-        list_node_t *node = sem->wait_list.head;
-        task_tcb *tcb = (task_tcb *)(node->owner_tcb);
+#if OS_SEM_FAST_PATH_ENABLE
+    // ûڵȣٽֱӷŻȥ
+    if (sem_give_fast(sem)) return;
+#endif
+
+    task_enter_critical();
+    sem_give_locked(sem);
+    task_exit_critical();
+}
 
-        // 2. ӵȴбƳ
-        list_remove(&sem->wait_list, node);
+// жϰ棺ٽѵҪж˳ (os_isr_exit) йȥ
+void sem_give_from_isr(sem_t *sem)
+{
+    uint32_t mask;
 
-        // 3. б
-        list_insert_end(&ReadyList[tcb->task_priority], node);
+#if OS_SEM_FAST_PATH_ENABLE
+    if (sem_give_fast(sem)) return;
+#endif
 
-        // 4. ָλͼ
-        bitmap_set(tcb->task_priority);
+    mask = os_isr_mask();
+    sem_give_locked(sem);
+    os_isr_unmask(mask);
+}
 
-        // 5.  (ռ)
-        if (OSSchedLockNesting == 0)
-        {
-            SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-        }
-    }
-    // --- Bû˵ȣ+1 ---
-    else
+// sem_give  (߸ٽ)
+static void sem_give_locked(sem_t *sem)
+{
+    // --- AŶӣֱӸȼߵǸ () ---
+    // ȼǰռֵŴ (ռ)
+    if (wait_queue_wake_one(&sem->wait_queue) == NULL)
     {
+        // --- Bû˵ȣ+1 ---
         sem->counter++;
-    }
 
-    __enable_irq();
+        //  select ĻȥǱߵǼһ
+        select_signal(&sem->select);
+    }
 }
 
 void sem_get_info(sem_t *sem, sem_info_t *info)
 {
     if (sem == NULL || info == NULL) return;
 
-    // 1. ж (ٽ֤һ)
-    __disable_irq();
+    // 1. ٽ֤һ
+    task_enter_critical();
 
     // 2. ȡǰ
     info->current_count = sem->counter;
 
     // 3. ȡȴб
-    info->waiting_tasks = sem->wait_list.count;
+    info->waiting_tasks = sem->wait_queue.count;
 
-    // 4. ж
-    __enable_irq();
+    // 4. ˳ٽ
+    task_exit_critical();
 }
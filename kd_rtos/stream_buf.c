@@ -0,0 +1,678 @@
+#include <string.h>
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "event.h"
+#include "os_delay.h"
+#include "mem_pool.h"
+
+// ============================================================
+//  (ֽ) / Ϣ (ͷı䳤Ϣ)
+// һ Bip-Buffer
+//   дȽ A 棻A Ų¡ A ǰ (ͷ) յø࣬Ϳ B
+//   Զ A A  B ͱµ A
+// һϢһдһռ (Ųɵ)ֱӵṹ
+// Ѱˮλܹ trigger_level ֽڲŽѽߣÿһֽڽһ
+// ͬһʱֻһд send_reserve (Ҳһ)һһж/һ
+// ============================================================
+
+// ϢͷһִϢȡÿϢ 4 ֽڶ룬ֱָӸ DMA
+#define MSG_HDR_SIZE        4u
+#define MSG_RECORD_SIZE(n)  ((MSG_HDR_SIZE + (n) + 3u) & ~3u)
+
+// ˶ֽ (ϢϢͷͶ)
+static uint32_t bip_count(stream_buf_t *sb)
+{
+    return (sb->a_end - sb->a_start) + (sb->b_active ? sb->b_end : 0);
+}
+
+// ============================================================
+// Ԥһдռ (߸ٽ)
+// *len ȥҪĳȣʵʸĳȣexact=1 ʱ *len Ͳ
+//  (߱ԤĻûύ)  NULL
+// ============================================================
+static uint8_t* bip_reserve(stream_buf_t *sb, uint32_t *len, uint32_t exact)
+{
+    uint32_t off, space;
+    uint8_t to_b;
+
+    if (sb->wr_len != 0) return NULL;
+
+    if (sb->b_active)
+    {
+        // B ãֻܽ B дд A Ϊֹ
+        off = sb->b_end;
+        space = sb->a_start - sb->b_end;
+        to_b = 1;
+    }
+    else if (sb->size - sb->a_end >= *len || sb->size - sb->a_end >= sb->a_start ||
+             (!exact && sb->size - sb->a_end != 0))
+    {
+        // A ŵ (ߺǰգֽܲд) A 
+        off = sb->a_end;
+        space = sb->size - sb->a_end;
+        to_b = 0;
+    }
+    else
+    {
+        // A Ų£ǰյøࣺӿͷһ B (A ʣµͷͲ)
+        off = 0;
+        space = sb->a_start;
+        to_b = 1;
+    }
+
+    if (space == 0 || (exact && space < *len)) return NULL;
+    if (*len > space) *len = space;
+
+    sb->wr_off = off;
+    sb->wr_len = *len;
+    sb->wr_to_b = to_b;
+
+    return sb->buf + off;
+}
+
+// ύԤĿռʵд˵ n ֽ (߸ٽ)
+static void bip_commit(stream_buf_t *sb, uint32_t n)
+{
+    if (n > sb->wr_len) n = sb->wr_len;
+
+    if (sb->wr_to_b)
+    {
+        if (n != 0 && sb->a_start == sb->a_end)
+        {
+            // Ԥڼ A ѾˣB ֱӵ A 
+            sb->a_start = sb->wr_off;
+            sb->a_end = sb->wr_off + n;
+        }
+        else if (n != 0)
+        {
+            sb->b_end = sb->wr_off + n;
+            sb->b_active = 1;
+        }
+    }
+    else
+    {
+        sb->a_end = sb->wr_off + n;
+    }
+    sb->wr_len = 0;
+}
+
+//  A Ŀͷ黹 n ֽ (߸ٽ)
+static void bip_release(stream_buf_t *sb, uint32_t n)
+{
+    sb->a_start += n;
+    if (sb->a_start < sb->a_end) return;
+
+    if (sb->b_active)
+    {
+        // A ˣB µ A
+        sb->a_start = 0;
+        sb->a_end = sb->b_end;
+        sb->b_end = 0;
+        sb->b_active = 0;
+        //  B дǿڽµ A 
+        sb->wr_to_b = 0;
+    }
+    else if (sb->wr_len != 0 && !sb->wr_to_b)
+    {
+        // ڽ A дA յλòܶ
+        sb->a_start = sb->a_end;
+    }
+    else
+    {
+        // ȫˣصͷ´ܸһռ
+        sb->a_start = 0;
+        sb->a_end = 0;
+    }
+}
+
+// ݹˮλ˾ͽһ (߸ٽ)
+static void bip_wake_reader(stream_buf_t *sb)
+{
+    if (bip_count(sb) < sb->trigger_level) return;
+
+    if (sb->recv_wait.count != 0)
+    {
+        wait_queue_wake_one(&sb->recv_wait);
+    }
+
+    //  select ĻȥǱߵǼһ
+    select_signal(&sb->select);
+}
+
+//  wq ˯һ (ٽʱҲٽ)
+//  OS_OK ʾ (ȥٲһ)ֱֵӷظû
+static int stream_block(wait_queue_t *wq, uint32_t start, uint32_t timeout)
+{
+    uint32_t remain = timeout;
+
+    if (timeout != OS_WAIT_FOREVER)
+    {
+        uint32_t passed = os_get_tick() - start;
+        remain = (passed < timeout) ? (timeout - passed) : 0;
+    }
+
+    if (remain == OS_NO_WAIT) return OS_ERR_TIMEOUT;
+
+    // ˣϽ
+    if (OSSchedLockNesting > 0) return OS_ERR;
+
+    wait_queue_block(wq, remain);
+    task_exit_critical();
+
+    // ... ߣȶԷѣ߳ʱ ...
+
+    task_enter_critical();
+    return current_tcb->wait_result;
+}
+
+//  (ṹʹ洢һ)
+static stream_buf_t* bip_create(uint32_t size, uint32_t trigger_level, event_type_t type)
+{
+    stream_buf_t *sb;
+
+    if (size == 0) return NULL;
+
+    sb = (stream_buf_t *)os_mem_alloc(sizeof(stream_buf_t) + size);
+    if (sb == NULL) return NULL;
+
+    sb->type = type;
+    wait_queue_init(&sb->recv_wait);
+    wait_queue_init(&sb->send_wait);
+    sb->buf = (uint8_t *)(sb + 1);
+    sb->size = size;
+    sb->a_start = 0;
+    sb->a_end = 0;
+    sb->b_end = 0;
+    sb->b_active = 0;
+    sb->wr_to_b = 0;
+    sb->wr_off = 0;
+    sb->wr_len = 0;
+    sb->trigger_level = trigger_level;
+    select_link_init(&sb->select, sb);
+
+    return sb;
+}
+
+// ɾߵŵȫѣǷ OS_ERR_DELETED (Ѿշֽ)
+static void bip_delete(stream_buf_t *sb)
+{
+    if (sb == NULL) return;
+
+    task_enter_critical();
+    wait_queue_wake_all(&sb->recv_wait, OS_ERR_DELETED);
+    wait_queue_wake_all(&sb->send_wait, OS_ERR_DELETED);
+    select_detach(&sb->select);
+    os_mem_free(sb);
+    task_exit_critical();
+}
+
+// ============================================================
+// 
+// ============================================================
+
+// 1.  (trigger_levelֽܹڲŻڵȵĽߣ 1)
+stream_buf_t* stream_buf_create(uint32_t size, uint32_t trigger_level)
+{
+    if (trigger_level == 0) trigger_level = 1;
+    if (trigger_level > size) trigger_level = size;
+    return bip_create(size, trigger_level, EVENT_TYPE_STREAM);
+}
+
+// 2. ɾ
+void stream_buf_delete(stream_buf_t *sb)
+{
+    bip_delete(sb);
+}
+
+// ˮλ (1 ~ size)ʱˮλ 1ˮλβҲϽڵȵĽ
+void stream_buf_set_trigger(stream_buf_t *sb, uint32_t trigger_level)
+{
+    if (sb == NULL || sb->type != EVENT_TYPE_STREAM) return;
+    if (trigger_level == 0) trigger_level = 1;
+    if (trigger_level > sb->size) trigger_level = sb->size;
+
+    task_enter_critical();
+    sb->trigger_level = trigger_level;
+    bip_wake_reader(sb);
+    task_exit_critical();
+}
+
+// ============================================================
+// 3.  len ֽڣռ䲻͵ ( timeout  Tick)
+// ʵдȥֽ (ʱ˿ֻдȥһ)
+// ============================================================
+uint32_t stream_buf_send(stream_buf_t *sb, const void *data, uint32_t len, uint32_t timeout)
+{
+    uint32_t start, n, sent = 0;
+    uint8_t *p;
+    int result;
+
+    if (sb == NULL || data == NULL) return 0;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    while (sent < len)
+    {
+        n = len - sent;
+        p = bip_reserve(sb, &n, 0);
+        if (p == NULL)
+        {
+            // дˣȰûˮλڵȵĽ߽ (Ȼ߻)ٵڵط
+            if (sent != 0 && sb->recv_wait.count != 0)
+            {
+                wait_queue_wake_one(&sb->recv_wait);
+            }
+
+            result = stream_block(&sb->send_wait, start, timeout);
+            if (result == OS_ERR_DELETED)
+            {
+                // Ѿûˣ
+                task_exit_critical();
+                return sent;
+            }
+            if (result != OS_OK) break;
+            continue;
+        }
+
+        memcpy(p, (const uint8_t *)data + sent, n);
+        bip_commit(sb, n);
+        sent += n;
+    }
+
+    if (sent != 0) bip_wake_reader(sb);
+
+    task_exit_critical();
+    return sent;
+}
+
+// жϰ棺ȣдд٣дȥֽ
+uint32_t stream_buf_send_from_isr(stream_buf_t *sb, const void *data, uint32_t len)
+{
+    uint32_t mask, n, sent = 0;
+    uint8_t *p;
+
+    if (sb == NULL || data == NULL) return 0;
+
+    mask = os_isr_mask();
+    // A һ顢B һ飬
+    while (sent < len)
+    {
+        n = len - sent;
+        p = bip_reserve(sb, &n, 0);
+        if (p == NULL) break;
+        memcpy(p, (const uint8_t *)data + sent, n);
+        bip_commit(sb, n);
+        sent += n;
+    }
+    if (sent != 0) bip_wake_reader(sb);
+    os_isr_unmask(mask);
+
+    return sent;
+}
+
+// ============================================================
+// 4. ԭдԤһռ (*len ȥҪ٣ʵʸ˶)
+// һռ䶼ûо͵ȣʱ NULLд stream_buf_send_commit
+// ============================================================
+uint8_t* stream_buf_send_reserve(stream_buf_t *sb, uint32_t *len, uint32_t timeout)
+{
+    uint32_t start;
+    uint8_t *p;
+
+    if (sb == NULL || len == NULL || *len == 0) return NULL;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    while ((p = bip_reserve(sb, len, 0)) == NULL)
+    {
+        if (stream_block(&sb->send_wait, start, timeout) != OS_OK)
+        {
+            task_exit_critical();
+            return NULL;
+        }
+    }
+
+    task_exit_critical();
+    return p;
+}
+
+// ύʵд˵ len ֽ
+void stream_buf_send_commit(stream_buf_t *sb, uint32_t len)
+{
+    if (sb == NULL) return;
+
+    task_enter_critical();
+    bip_commit(sb, len);
+    bip_wake_reader(sb);
+    // Ԥڼд߱ˣһ
+    wait_queue_wake_one(&sb->send_wait);
+    task_exit_critical();
+}
+
+// ============================================================
+// 5.  len ֽڣյľ͵ ( timeout  Tick)
+// ʵʶֽ (ʱʱжٸ٣һֽڶûСɾ 0)
+// ע⣺ȵʱҪܹˮλŻᱻѣˮλβҪʱ ( stream_buf_set_trigger) 
+// ============================================================
+uint32_t stream_buf_recv(stream_buf_t *sb, void *buf, uint32_t len, uint32_t timeout)
+{
+    uint32_t start, n, got = 0;
+    int result;
+
+    if (sb == NULL || buf == NULL) return 0;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    while (bip_count(sb) == 0)
+    {
+        result = stream_block(&sb->recv_wait, start, timeout);
+        if (result != OS_OK)
+        {
+            // ʱˣûˮλûǽѵǵȥ (ɾ˵Ļ sb Ѿû)
+            if (result != OS_ERR_DELETED && bip_count(sb) != 0) break;
+            task_exit_critical();
+            return 0;
+        }
+    }
+
+    // ȶ AA  B µ A
+    while (got < len && (n = sb->a_end - sb->a_start) != 0)
+    {
+        if (n > len - got) n = len - got;
+        memcpy((uint8_t *)buf + got, sb->buf + sb->a_start, n);
+        bip_release(sb, n);
+        got += n;
+    }
+
+    // ڳ˵طڵȿռͽһ
+    wait_queue_wake_one(&sb->send_wait);
+
+    task_exit_critical();
+    return got;
+}
+
+// ============================================================
+// 6. ԭضһݵ㣬*len س
+// յľ͵ȣʱʱжٸ٣һֽڶûвŷ NULL
+//  stream_buf_recv_release 黹ʵõ˶
+// ============================================================
+uint8_t* stream_buf_recv_peek(stream_buf_t *sb, uint32_t *len, uint32_t timeout)
+{
+    uint32_t start;
+    uint8_t *p;
+    int result;
+
+    if (sb == NULL || len == NULL) return NULL;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    while (bip_count(sb) == 0)
+    {
+        result = stream_block(&sb->recv_wait, start, timeout);
+        if (result != OS_OK)
+        {
+            // ͬ stream_buf_recvʱʱ򲻹ˮλҲȥ
+            if (result != OS_ERR_DELETED && bip_count(sb) != 0) break;
+            task_exit_critical();
+            *len = 0;
+            return NULL;
+        }
+    }
+
+    p = sb->buf + sb->a_start;
+    *len = sb->a_end - sb->a_start;
+
+    task_exit_critical();
+    return p;
+}
+
+void stream_buf_recv_release(stream_buf_t *sb, uint32_t len)
+{
+    if (sb == NULL) return;
+
+    task_enter_critical();
+    if (len > sb->a_end - sb->a_start) len = sb->a_end - sb->a_start;
+    bip_release(sb, len);
+    wait_queue_wake_one(&sb->send_wait);
+    task_exit_critical();
+}
+
+// ǰ˶ֽ
+uint32_t stream_buf_count(stream_buf_t *sb)
+{
+    uint32_t n;
+
+    if (sb == NULL) return 0;
+
+    task_enter_critical();
+    n = bip_count(sb);
+    task_exit_critical();
+
+    return n;
+}
+
+// ============================================================
+// Ϣ
+// ÿϢǰһֵĳͷյʱһһ
+// ============================================================
+
+// 1.  (size ȡ 4 ı)
+msg_buf_t* msg_buf_create(uint32_t size)
+{
+    return bip_create((size + 3u) & ~3u, 1, EVENT_TYPE_MSG_BUF);
+}
+
+// 2. ɾ
+void msg_buf_delete(msg_buf_t *mb)
+{
+    bip_delete(mb);
+}
+
+// һϢдԤõĿռ (߸ٽ)
+static void msg_put_locked(msg_buf_t *mb, uint8_t *p, const void *data, uint32_t len)
+{
+    *(uint32_t *)p = len;
+    memcpy(p + MSG_HDR_SIZE, data, len);
+    bip_commit(mb, MSG_RECORD_SIZE(len));
+    bip_wake_reader(mb);
+}
+
+// ============================================================
+// 3. һϢ (ҪôдȥҪôд)
+//  OS_OK ȥˣOS_ERR_TIMEOUT ռ䲻ȳʱOS_ERR_DELETED ɾˣ
+// OS_ERR  (Ϣ) ߵס
+// ============================================================
+int msg_buf_send(msg_buf_t *mb, const void *data, uint32_t len, uint32_t timeout)
+{
+    uint32_t start, rec;
+    uint8_t *p;
+    int result;
+
+    if (mb == NULL || (data == NULL && len != 0)) return OS_ERR;
+    if (MSG_RECORD_SIZE(len) > mb->size) return OS_ERR;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    // ҪһռϢ
+    while (rec = MSG_RECORD_SIZE(len), (p = bip_reserve(mb, &rec, 1)) == NULL)
+    {
+        result = stream_block(&mb->send_wait, start, timeout);
+        if (result != OS_OK)
+        {
+            task_exit_critical();
+            return result;
+        }
+    }
+
+    msg_put_locked(mb, p, data, len);
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// жϰ棺ȣŲ· OS_ERR_TIMEOUT
+int msg_buf_send_from_isr(msg_buf_t *mb, const void *data, uint32_t len)
+{
+    uint32_t mask, rec;
+    uint8_t *p;
+    int result = OS_ERR_TIMEOUT;
+
+    if (mb == NULL || (data == NULL && len != 0)) return OS_ERR;
+    if (MSG_RECORD_SIZE(len) > mb->size) return OS_ERR;
+
+    mask = os_isr_mask();
+    rec = MSG_RECORD_SIZE(len);
+    p = bip_reserve(mb, &rec, 1);
+    if (p != NULL)
+    {
+        msg_put_locked(mb, p, data, len);
+        result = OS_OK;
+    }
+    os_isr_unmask(mask);
+
+    return result;
+}
+
+// ============================================================
+// 4. ԭдһ len ֽڵϢϢĵַ (4 ֽڶ)ʱ NULL
+// д msg_buf_send_commit ύʵʳ (ܳ len)
+// ============================================================
+void* msg_buf_send_reserve(msg_buf_t *mb, uint32_t len, uint32_t timeout)
+{
+    uint32_t start, rec;
+    uint8_t *p;
+
+    if (mb == NULL || MSG_RECORD_SIZE(len) > mb->size) return NULL;
+
+    task_enter_critical();
+    start = os_get_tick();
+
+    while (rec = MSG_RECORD_SIZE(len), (p = bip_reserve(mb, &rec, 1)) == NULL)
+    {
+        if (stream_block(&mb->send_wait, start, timeout) != OS_OK)
+        {
+            task_exit_critical();
+            return NULL;
+        }
+    }
+
+    task_exit_critical();
+    return p + MSG_HDR_SIZE;
+}
+
+void msg_buf_send_commit(msg_buf_t *mb, uint32_t len)
+{
+    if (mb == NULL) return;
+
+    task_enter_critical();
+    if (mb->wr_len != 0 && MSG_RECORD_SIZE(len) <= mb->wr_len)
+    {
+        *(uint32_t *)(mb->buf + mb->wr_off) = len;
+        bip_commit(mb, MSG_RECORD_SIZE(len));
+        bip_wake_reader(mb);
+    }
+    else
+    {
+        // ԤĻ
+        bip_commit(mb, 0);
+    }
+    wait_queue_wake_one(&mb->send_wait);
+    task_exit_critical();
+}
+
+// ȵһϢ (ٽ)
+static int msg_wait_locked(msg_buf_t *mb, uint32_t timeout)
+{
+    uint32_t start = os_get_tick();
+    int result;
+
+    while (bip_count(mb) == 0)
+    {
+        result = stream_block(&mb->recv_wait, start, timeout);
+        if (result != OS_OK) return result;
+    }
+    return OS_OK;
+}
+
+// ============================================================
+// 5. һϢ buf  (*len Ϣ)
+//  OS_OK յˣOS_ERR_TIMEOUT ʱOS_ERR_DELETED ɾˣ
+// OS_ERR buf Ų (Ϣڻ*len Ҫ)
+// ============================================================
+int msg_buf_recv(msg_buf_t *mb, void *buf, uint32_t max_len, uint32_t *len, uint32_t timeout)
+{
+    uint32_t n;
+    int result;
+
+    if (mb == NULL || len == NULL) return OS_ERR;
+
+    task_enter_critical();
+
+    result = msg_wait_locked(mb, timeout);
+    if (result != OS_OK)
+    {
+        task_exit_critical();
+        *len = 0;
+        return result;
+    }
+
+    // Ϣһ A Ŀͷ
+    n = *(uint32_t *)(mb->buf + mb->a_start);
+    *len = n;
+    if (n > max_len || (buf == NULL && n != 0))
+    {
+        task_exit_critical();
+        return OS_ERR;
+    }
+
+    memcpy(buf, mb->buf + mb->a_start + MSG_HDR_SIZE, n);
+    bip_release(mb, MSG_RECORD_SIZE(n));
+    wait_queue_wake_one(&mb->send_wait);
+
+    task_exit_critical();
+    return OS_OK;
+}
+
+// ============================================================
+// 6. ԭضǰϢϢ (4 ֽڶ)*len سȣʱ NULL
+//  msg_buf_recv_release Ϣӵ
+// ============================================================
+void* msg_buf_recv_peek(msg_buf_t *mb, uint32_t *len, uint32_t timeout)
+{
+    uint8_t *p;
+
+    if (mb == NULL || len == NULL) return NULL;
+
+    task_enter_critical();
+
+    if (msg_wait_locked(mb, timeout) != OS_OK)
+    {
+        task_exit_critical();
+        *len = 0;
+        return NULL;
+    }
+
+    p = mb->buf + mb->a_start;
+    *len = *(uint32_t *)p;
+
+    task_exit_critical();
+    return p + MSG_HDR_SIZE;
+}
+
+void msg_buf_recv_release(msg_buf_t *mb)
+{
+    if (mb == NULL) return;
+
+    task_enter_critical();
+    if (bip_count(mb) != 0)
+    {
+        bip_release(mb, MSG_RECORD_SIZE(*(uint32_t *)(mb->buf + mb->a_start)));
+        wait_queue_wake_one(&mb->send_wait);
+    }
+    task_exit_critical();
+}
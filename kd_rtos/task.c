@@ -1,17 +1,23 @@
 #include <stdint.h>
-#include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "task.h"
 #include "scheduler.h"
 #include "stm32f4xx.h"
 #include "cpu_tick.h"
+#include "mem_pool.h"
 extern list_t ReadyList[MAX_PRIORITY];
-extern list_t DelayedList;
 extern task_tcb *current_tcb;
 
 // ȫٽǶ׼ʼΪ 0
 volatile uint32_t critical_nesting = 0;
 
+//  (PendSV) õ BASEPRI ֵûֱ os_config.h ĺ
+const uint32_t os_kernel_basepri = OS_KERNEL_BASEPRI;
+
+// 񴮳ɵ (ͷ)
+task_tcb *task_list_head = NULL;
+
 /*----------------------------------------------------------------*/
 /* 궨ȫֱ                                               */
 /*----------------------------------------------------------------*/
@@ -19,6 +25,9 @@ volatile uint32_t critical_nesting = 0;
 // xPSR.T = 1 (24λ)ָʾ CPU  Thumb ״̬ HardFault
 #define XPSR_T_BIT ((uint32_t)0x01000000L)
 
+//  EXC_RETURN߳ģʽ PSP֡ (һ FPU ӲԼ)
+#define EXC_RETURN_THREAD_PSP ((uint32_t)0xFFFFFFFDL)
+
 // ⲿ (ʱӲ߼)
 extern task_tcb *task1;
 extern task_tcb *task2;
@@ -36,7 +45,8 @@ uint32_t *task_stack_init(void *task_function, uint32_t *stack_top);
  * @param  task_function ڵַ
  * @param  stack_top     ջ׵ַ (ߵַ)
  * @return uint32_t* ʼջָ (SP)
- * @note   ջṹ Cortex-M4 쳣֡׼ + R4-R11 ֡
+ * @note   ջṹ Cortex-M4 쳣֡׼ + R4-R11/EXC_RETURN ֡
+ *         һʼ֡һ FPU  PendSV Ż渡Ĵ
  */
 uint32_t* task_stack_init(void *task_function, uint32_t *stack_top)
 {
@@ -53,6 +63,7 @@ uint32_t* task_stack_init(void *task_function, uint32_t *stack_top)
     *(--sp) = 0;                    // R0
 
     /* --- 2. ֶѹջ (Software Saved) --- */
+    *(--sp) = EXC_RETURN_THREAD_PSP; // EXC_RETURN (PendSV жûи֡)
     *(--sp) = 0;                    // R11
     *(--sp) = 0;                    // R10
     *(--sp) = 0;                    // R9
@@ -74,23 +85,44 @@ uint32_t* task_stack_init(void *task_function, uint32_t *stack_top)
  */
 task_tcb* task_create(void *task_function, uint32_t task_stack_depth, char *task_name,uint32_t task_priority)
 {
-    // 1.  TCB ڴ
-    task_tcb *new_task_tcb = (task_tcb *)malloc(sizeof(task_tcb));
+    return task_create_ex(task_function, task_stack_depth, task_name, task_priority, 0);
+}
+
+/**
+ * @brief   (ѡ)
+ * @param  options TASK_OPT_FPUø (CMSIS-DSP ֮)ջ϶ֳĿռ
+ * @note   Ҫ TASK_OPT_FPUʡ TASK_FPU_FRAME_WORDS ֵջ
+ */
+task_tcb* task_create_ex(void *task_function, uint32_t task_stack_depth, char *task_name,
+                         uint32_t task_priority, uint32_t options)
+{
+    // øлʱջҪ S0-S15/FPSCR (Ӳ) + S16-S31 ()
+    if (options & TASK_OPT_FPU)
+    {
+        task_stack_depth += TASK_FPU_FRAME_WORDS;
+    }
+
+    // 1.  TCB ڴ (ںڴ)
+    task_tcb *new_task_tcb = (task_tcb *)os_mem_alloc(sizeof(task_tcb));
     if (new_task_tcb == NULL)
     {
         return NULL;
     }
 
+    // 㣬ֹڴ ( notify_stateͳƼ)
+    memset(new_task_tcb, 0, sizeof(task_tcb));
+
     // 2. ջڴ
-    uint32_t *stack_start = (uint32_t *)malloc(task_stack_depth * sizeof(uint32_t));
+    uint32_t *stack_start = (uint32_t *)os_mem_alloc(task_stack_depth * sizeof(uint32_t));
     if (stack_start == NULL)
     {
-        free(new_task_tcb);
+        os_mem_free(new_task_tcb);
         return NULL;
     }
 
     // 3. ջ׵ַ (Cortex-M ջջڸߵַ)
-    uint32_t *stack_top_addr = stack_start + task_stack_depth;
+    //  8 ֽڶ (AAPCS Ҫ󣬸֡Ҳ)
+    uint32_t *stack_top_addr = (uint32_t *)((uintptr_t)(stack_start + task_stack_depth) & ~(uintptr_t)7);
 
     // 4. ʼջռ䣬µ SP 浽 TCB
     new_task_tcb->stack_ptr = task_stack_init(task_function, stack_top_addr);
@@ -100,36 +132,110 @@ task_tcb* task_create(void *task_function, uint32_t task_stack_depth, char *task
     new_task_tcb->task_stack_depth = task_stack_depth;
     new_task_tcb->task_name = task_name;
     new_task_tcb->task_priority = task_priority;
+    new_task_tcb->base_priority = task_priority;
+    new_task_tcb->preempt_threshold = task_priority;
+    new_task_tcb->slice_remaining = OS_TIME_SLICE_TICKS;
+    new_task_tcb->task_options = options;
 
     // 6. ʼڵ ()
     new_task_tcb->status_node.next= NULL;
     new_task_tcb->status_node.prev = NULL;
     new_task_tcb->status_node.owner_tcb = (void *)new_task_tcb;
+    new_task_tcb->delay_node.owner_tcb = (void *)new_task_tcb;
+
+    task_enter_critical();
 
     // 7. б ()
-    // صӦȼ ReadyList ĩβ
-    list_insert_end(&ReadyList[task_priority], &new_task_tcb->status_node);
+    // صӦȼ ReadyList ĩβ
+    // ͬʱȼλͼ (Ǽ)ߵȼˣ´οԵ
+    task_ready_insert(new_task_tcb);
+
+    // 9. Ǽǵȫ (ͳ)
+    new_task_tcb->task_next = task_list_head;
+    task_list_head = new_task_tcb;
 
-    // 8. ȼλͼ (Ǽ)
-    // ߵȼˣ´οԵ
-    bitmap_set(task_priority);
+    task_exit_critical();
 
     return new_task_tcb;
 }
 
+/**
+ * @brief  ռֵ
+ * @param  threshold ռֵܵȼ
+ * @return 0 ɹ-1 
+ * @note   һ黥Эֵȼ˴֮Ͳռ
+ *         ֻб鶼ߵܴǣʡҪл
+ */
+int task_set_preempt_threshold(task_tcb *tcb, uint32_t threshold)
+{
+    if (tcb == NULL || threshold < tcb->base_priority || threshold >= MAX_PRIORITY)
+    {
+        return -1;
+    }
+
+    task_enter_critical();
+
+    tcb->preempt_threshold = threshold;
+
+    // ֵͺ󣬿ѾйʸռŶ
+    if (OSSchedLockNesting == 0)
+    {
+        SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    }
+
+    task_exit_critical();
+    return 0;
+}
+
+/**
+ * @brief  ʱƬ
+ * @param  ticks ʱƬ (λTick)0 ʾָĬϵ OS_TIME_SLICE_TICKS
+ */
+void task_set_time_slice(task_tcb *tcb, uint32_t ticks)
+{
+    if (tcb == NULL) return;
+
+    task_enter_critical();
+    tcb->time_slice = ticks;
+    tcb->slice_remaining = (ticks != 0) ? ticks : OS_TIME_SLICE_TICKS;
+    task_exit_critical();
+}
+
 // ============================================================
 // ٽ (Enter Critical)
-// ߼ж ->  1
+// ߼ BASEPRI ں˹ܵõж ->  1
+// ٹȫжϣȼ OS_MAX_SYSCALL_PRIORITY ߵжʱ
 // ============================================================
 void task_enter_critical(void)
 {
-    task_enter_critical(); // жϣ֤ԭ
+    __set_BASEPRI_MAX(OS_KERNEL_BASEPRI); // Σ֤ԭ (ֻģɵе)
+    __DSB();
+    __ISB();                          // ֤һִָǰѾЧ
     critical_nesting++;
 }
 
+// ============================================================
+// жõٽ (*_from_isr )
+//  critical_nestingֱӱ/ָ BASEPRIǶ׵ж֮Ҳụ
+//  BASEPRI_MAXѾεø (BASEPRI ָС) Ļֲ䣬ᱻ
+// ============================================================
+uint32_t os_isr_mask(void)
+{
+    uint32_t old = __get_BASEPRI();
+    __set_BASEPRI_MAX(OS_KERNEL_BASEPRI);
+    __DSB();
+    __ISB();
+    return old;
+}
+
+void os_isr_unmask(uint32_t old)
+{
+    __set_BASEPRI(old);
+}
+
 // ============================================================
 // ˳ٽ (Exit Critical)
-// ߼ 1 ->  0 ˣж
+// ߼ 1 ->  0 ˣ
 // ============================================================
 void task_exit_critical(void)
 {
@@ -139,7 +245,7 @@ void task_exit_critical(void)
         // ֻеǶײʱ˵ı
         if (critical_nesting == 0)
         {
-            task_exit_critical();
+            __set_BASEPRI(0);
         }
     }
 }
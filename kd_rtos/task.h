@@ -3,46 +3,176 @@
 
 #include <stdint.h>
 #include "list.h"
+#include "os_config.h"
+
+struct mutex;
+struct wait_queue;
 
 // ȫٽǶ׼
 extern volatile uint32_t critical_nesting;
 
-// ٽ
+// ںٽд BASEPRI ֵ (ȼ 8 λֶεĸ __NVIC_PRIO_BITS λ)
+#define OS_KERNEL_BASEPRI   (OS_MAX_SYSCALL_PRIORITY << (8 - __NVIC_PRIO_BITS))
+
+// ٽ ( BASEPRI Σȫж)
 void task_enter_critical(void);
 void task_exit_critical(void);
+uint32_t os_isr_mask(void);
+void os_isr_unmask(uint32_t old);
 
 // ֪ͨ״̬
 #define NOTIFY_NONE     0 // ֪ͨҲûڵ
 #define NOTIFY_PENDING  1 // ֪ͨ ()
 #define NOTIFY_WAITING  2 // ֪ͨ (˯)
 
-//*ȼ ( 32Ӧһ uint32_t λͼ)
-#define MAX_PRIORITY  32
+// ֪ͨĶ (task_notify_ex)
+#define NOTIFY_ACTION_NONE          0 // ֻѣֵ
+#define NOTIFY_ACTION_SET_BITS      1 // ֵ |= value (¼)
+#define NOTIFY_ACTION_INCREMENT     2 // ֵ + 1 (ź)
+#define NOTIFY_ACTION_OVERWRITE     3 // ֵ = value ()
+#define NOTIFY_ACTION_NO_OVERWRITE  4 // һ֪ͨûȡ߾ʧܣֵ = value
 
-typedef struct
+// õĳʱ (λTick)
+#define OS_NO_WAIT          0u          // ȣò̷
+#define OS_WAIT_FOREVER     0xFFFFFFFFu // һֱ
+
+// ں API ֵ
+#define OS_OK               0
+#define OS_ERR              (-1)        //  / סʱ
+#define OS_ERR_TIMEOUT      (-2)        // ȳʱ
+#define OS_ERR_DELETED      (-3)        // ȵĶɾ
+
+//*̶ռȼ 0
+#define IDLE_TASK_PRIORITY  0
+
+// task_create_ex ѡ
+#define TASK_OPT_FPU            0x01 //  FPU
+#define TASK_OPT_EDF            0x02 // EDF  (task_create_edf Լ裬Ҫֶ)
+
+// ֳռջ ()Ӳ S0-S15 + FPSCR + λ 18  S16-S31 16 
+#define TASK_FPU_FRAME_WORDS    34
+
+// CPU ԤùԺĴʽ
+#define BUDGET_ACTION_DEMOTE    0 //  OS_BUDGET_BG_PRIORITY 
+#define BUDGET_ACTION_SUSPEND   1 // 𣬵Ԥ㲹
+
+typedef struct task_tcb
 {
     //! ջָTCBĵһԱڻлʱܼ򻯴
     uint32_t *stack_ptr;
     uint32_t task_priority;
     uint32_t task_stack_depth;
-    list_node_t status_node;
+    list_node_t status_node;    // ھб / IPC ȴ
+    list_node_t delay_node;     // ʱʱ (ʱߵ IPC ĳʱ)
+    int32_t wait_result;        // ȴĽOS_OK / OS_ERR_TIMEOUT / OS_ERR_DELETED
     void *task_function;
     char *task_name;
-    // !!! ʱ () !!!
-    uint32_t delay_ticks;
+    uint32_t task_options;  // task_create_ex ѡ (TASK_OPT_FPU ...)
+    // !!! ֪ͨרֶ (ÿ OS_TASK_NOTIFY_SLOTS ) !!!
+    uint32_t notify_value[OS_TASK_NOTIFY_SLOTS];  // ˽ (ֵ)
+    uint8_t  notify_state[OS_TASK_NOTIFY_SLOTS];  // ״̬ (ûţǷڵ)
+    uint8_t  notify_wait_index;                   // ڵĸ
+
+    // !!! CPU ռͳ (PendSV  DWT ڼ) !!!
+    uint64_t run_cycles;        // ۼе CPU 
+    uint64_t run_cycles_mark;   // ϴβʱ run_cycles
+    uint32_t switch_count;      // ۼƱĴ
+    uint32_t switch_count_mark; // ϴβʱ switch_count
+
+    struct task_tcb *task_next; // 񴮳һ (ͳʱ)
+
+    // !!! ȼ̳ !!!
+    uint32_t base_priority;     // ʱԭʼȼ (task_priority Ǽ̳кʵȼ)
+    struct mutex *held_mutex;   // ǰеĻ
+    struct mutex *wait_mutex;   // ڵȴĻ (ûڵȾ NULL)
+    struct wait_queue *wait_queue; // ĸȴ˯ (ûڵȾ NULL)
 
-    // !!! ֪ͨרֶ !!!
-    uint32_t notify_value;  // ˽ (ֵ)
-    uint8_t  notify_state;  // ״̬ (ûţǷڵ)
+    // !!! ¼ʱĵȴ (event_group.c ) !!!
+    uint32_t event_wait_bits;   // ڵЩλ
+    uint8_t  event_wait_opt;    // EVENT_WAIT_ALL / EVENT_CLEAR_ON_EXIT ...
+    uint32_t event_got_bits;    // һ̵ı־ (󷵻ظ)
+
+    // !!! ռֵ (ͬ ThreadX) !!!
+    // ʱֻȼֵռĬϵȼ
+    uint32_t preempt_threshold;
+
+    // !!! ʱƬ !!!
+    uint32_t time_slice;        // ʱƬ (Tick)0 ʾĬϵ OS_TIME_SLICE_TICKS
+    uint32_t slice_remaining;   // ǰʱƬʣ Tick
+
+    // !!! EDF  (task_options  TASK_OPT_EDF  EDF ) !!!
+    // ڡͷʱ̡Щͨ period_* ֶ
+    uint32_t edf_deadline;      // ڵľԽֹʱ (б)
+    uint32_t edf_util;          // ʱ (֮һ)
+
+    // !!! CPU Ԥ (budget_cycles Ϊ 0 ʾ) !!!
+    uint32_t budget_cycles;         // ÿڵԤ (CPU )
+    uint32_t budget_period;         //  (Tick)
+    uint32_t budget_used;           // Ѿõ
+    uint32_t budget_replenish_tick; // ´βľ Tick
+    uint8_t  budget_action;         // ùԺBUDGET_ACTION_DEMOTE / BUDGET_ACTION_SUSPEND
+    uint8_t  budget_state;          // Ԥ״̬ (budget.c ڲ)
+    uint32_t budget_saved_prio;     // ǰԭʼȼ
+    uint32_t budget_saved_threshold;// ǰռֵ
+    uint32_t budget_overruns;       // Ԥù (֧) Ĵ
+    uint32_t budget_overrun_max;    // ֳ֧ʱ೬˶
+    struct task_tcb *budget_next;   // Ԥ񴮳һ
+
+    // !!!  (period_ticks Ϊ 0 ĲEDF Ҳһ) !!!
+    uint32_t period_ticks;          //  (Tick)
+    uint32_t period_deadline;       // Խֹʱ (Tick)
+    uint32_t period_release;        // ڵͷʱ ( Tick)
+    uint32_t period_jobs;           // ɵ
+    uint32_t period_miss;           // ֹʱĴ
+    uint32_t period_jitter_last;    // ¶ CPU 
+    uint32_t period_jitter_max;
+    uint32_t period_resp_last;
+    uint32_t period_resp_max;
+    uint64_t period_resp_sum;
 }task_tcb;
 
+// ͳ (ʱ䵥λ΢룬ӱڵͷʱ)
+typedef struct
+{
+    uint32_t jobs;            // Ѿɵ
+    uint32_t deadline_miss;   // ֹʱĴ (̫౻Ҳ)
+    uint32_t jitter_last_us;  // ͷŶͷʱ̵ʼ
+    uint32_t jitter_max_us;
+    uint32_t response_last_us;// Ӧʱ䣺ͷʱ̵ ( task_wait_period)
+    uint32_t response_max_us;
+    uint32_t response_avg_us;
+} period_stats_t;
+
+// Ѵͷ
+extern task_tcb *task_list_head;
+
 task_tcb* task_create(void *task_function, uint32_t task_stack_depth, char *task_name,uint32_t task_priority);
+task_tcb* task_create_ex(void *task_function, uint32_t task_stack_depth, char *task_name,
+                         uint32_t task_priority, uint32_t options);
 void bitmap_set(uint32_t prio);
+int task_set_preempt_threshold(task_tcb *tcb, uint32_t threshold);
+void task_set_time_slice(task_tcb *tcb, uint32_t ticks);
+
+// EDF  (Ҫ OS_EDF_ENABLE)
+task_tcb* task_create_edf(void *task_function, uint32_t task_stack_depth, char *task_name,
+                          uint32_t wcet, uint32_t period, uint32_t deadline);
+void edf_wait_next_period(void);
+uint32_t edf_get_utilization(void);
+
+// CPU Ԥ (Ҫ OS_BUDGET_ENABLE)
+int task_set_budget(task_tcb *tcb, uint32_t budget_us, uint32_t period_ticks, uint32_t action);
 
 // 
 void start_scheduler(void);
 
 // ʱ
 void os_delay(uint32_t ticks);
+void os_delay_until(uint32_t *last_wake, uint32_t period);
+
+// 
+task_tcb* task_create_periodic(void *task_function, uint32_t task_stack_depth, char *task_name,
+                               uint32_t task_priority, uint32_t period, uint32_t deadline);
+void task_wait_period(void);
+int task_get_period_stats(task_tcb *tcb, period_stats_t *stats, uint32_t reset);
 
 #endif /* __TASK_H__ */
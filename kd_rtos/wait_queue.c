@@ -0,0 +1,145 @@
+#include "stm32f4xx.h"
+#include "scheduler.h"
+#include "wait_queue.h"
+#include "os_delay.h"
+
+// ȼ -> Ͱ (ȼԽͰԽ)
+#define WQ_BUCKET(prio)   ((uint32_t)(((prio) * OS_WAIT_QUEUE_BUCKETS) / MAX_PRIORITY))
+
+// ============================================================
+// ʼ
+// ============================================================
+void wait_queue_init(wait_queue_t *wq)
+{
+    uint32_t i;
+
+    for (i = 0; i < OS_WAIT_QUEUE_BUCKETS; i++)
+    {
+        list_init(&wq->bucket[i]);
+    }
+    wq->bitmap = 0;
+    wq->count = 0;
+}
+
+// ============================================================
+// ȴ (ʱκ)
+// ͬһͰﰴȼӸߵţͬȼǰ
+// ============================================================
+void wait_queue_add(wait_queue_t *wq, task_tcb *tcb)
+{
+    uint32_t b = WQ_BUCKET(tcb->task_priority);
+    list_t *list = &wq->bucket[b];
+    list_node_t *node = list->head;
+    list_node_t *pos = NULL;
+    uint32_t i;
+
+    for (i = 0; i < list->count; i++)
+    {
+        if (((task_tcb *)(node->owner_tcb))->task_priority < tcb->task_priority)
+        {
+            pos = node;
+            break;
+        }
+        node = node->next;
+    }
+
+    list_insert_before(list, pos, &tcb->status_node);
+    wq->bitmap |= (1u << b);
+    wq->count++;
+    tcb->wait_queue = wq;
+}
+
+// ============================================================
+// ӵȴժ
+// ============================================================
+void wait_queue_remove(wait_queue_t *wq, task_tcb *tcb)
+{
+    uint32_t b = WQ_BUCKET(tcb->task_priority);
+
+    list_remove(&wq->bucket[b], &tcb->status_node);
+    if (wq->bucket[b].head == NULL)
+    {
+        wq->bitmap &= ~(1u << b);
+    }
+    wq->count--;
+    tcb->wait_queue = NULL;
+}
+
+// ============================================================
+// 鿴ȼߵĵȴ (ժ)û˵ȷ NULL
+// ============================================================
+task_tcb* wait_queue_peek(wait_queue_t *wq)
+{
+    if (wq->bitmap == 0) return NULL;
+    return (task_tcb *)(wq->bucket[31 - __CLZ(wq->bitmap)].head->owner_tcb);
+}
+
+// ============================================================
+// ǰȥȴ˯ (֤߱û)
+// timeout  OS_WAIT_FOREVER Ļͬʱʱ֣ Tick Ӷժ
+// лҪȵ˳ٽ current_tcb->wait_result
+// ============================================================
+void wait_queue_block(wait_queue_t *wq, uint32_t timeout)
+{
+    task_ready_remove(current_tcb);
+    wait_queue_add(wq, current_tcb);
+    os_delay_arm(current_tcb, timeout);
+    current_tcb->wait_result = OS_OK;
+    SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+}
+
+// ============================================================
+// ѵȴߴӶ (Żؾб)ĳʱ
+// ʱͻѶٽ˭˭߶ժɾľҲ
+// ============================================================
+void wait_queue_take(wait_queue_t *wq, task_tcb *tcb, int32_t result)
+{
+    wait_queue_remove(wq, tcb);
+    os_delay_cancel(tcb);
+    tcb->wait_result = result;
+}
+
+// ============================================================
+// ȼߵĵȴߣرѵ (û˵ȷ NULL)
+// ռǰŴ (жƳٵж˳)
+// ============================================================
+task_tcb* wait_queue_wake_one(wait_queue_t *wq)
+{
+    task_tcb *tcb = wait_queue_peek(wq);
+
+    if (tcb != NULL)
+    {
+        wait_queue_take(wq, tcb, OS_OK);
+        task_ready_wake(tcb);
+    }
+    return tcb;
+}
+
+// ============================================================
+// еȴ (ɾʱ峡ãresult  OS_ERR_DELETED)ػѵĸ
+// ============================================================
+uint32_t wait_queue_wake_all(wait_queue_t *wq, int32_t result)
+{
+    task_tcb *tcb;
+    uint32_t n = 0;
+
+    while ((tcb = wait_queue_peek(wq)) != NULL)
+    {
+        wait_queue_take(wq, tcb, result);
+        task_ready_wake(tcb);
+        n++;
+    }
+    return n;
+}
+
+// ============================================================
+// ȴеȼ (ȼ̳)ȼӦλ
+// ============================================================
+void wait_queue_requeue(task_tcb *tcb, uint32_t new_prio)
+{
+    wait_queue_t *wq = tcb->wait_queue;
+
+    wait_queue_remove(wq, tcb);
+    tcb->task_priority = new_prio;
+    wait_queue_add(wq, tcb);
+}
@@ -0,0 +1,32 @@
+#ifndef __WAIT_QUEUE_H
+#define __WAIT_QUEUE_H
+
+#include <stdint.h>
+#include "list.h"
+#include "task.h"
+
+// ============================================================
+// ں˵ȴ ( IPC )
+// ȼͰÿͰһһ 32 λͼ¼ЩͰǿգ
+// ȼĵȴ = һ CLZ + ȡͰͷO(1)
+// ȼͰʱͬһͰﰴȼ (Ͱֻͨһ)
+// ============================================================
+typedef struct wait_queue
+{
+    list_t bucket[OS_WAIT_QUEUE_BUCKETS]; // bucket[i] ȼڵ i ε
+    uint32_t bitmap;                      //  i λ = bucket[i] ǿ
+    uint32_t count;                       // ȴ
+} wait_queue_t;
+
+// ºҪѾٽ
+void wait_queue_init(wait_queue_t *wq);
+void wait_queue_add(wait_queue_t *wq, task_tcb *tcb);
+void wait_queue_remove(wait_queue_t *wq, task_tcb *tcb);
+task_tcb* wait_queue_peek(wait_queue_t *wq);
+void wait_queue_block(wait_queue_t *wq, uint32_t timeout);
+void wait_queue_take(wait_queue_t *wq, task_tcb *tcb, int32_t result);
+task_tcb* wait_queue_wake_one(wait_queue_t *wq);
+uint32_t wait_queue_wake_all(wait_queue_t *wq, int32_t result);
+void wait_queue_requeue(task_tcb *tcb, uint32_t new_prio);
+
+#endif